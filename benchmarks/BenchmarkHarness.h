@@ -0,0 +1,131 @@
+#ifndef GRAVITY_SIMULATOR_BENCHMARKHARNESS_H
+#define GRAVITY_SIMULATOR_BENCHMARKHARNESS_H
+
+// Tiny Google-Benchmark-style harness: every case is run with a growing
+// iteration count until it takes at least `minTime` seconds, then the mean
+// time per iteration is recorded. Results go to stdout as a table and can be
+// written as JSON (same layout as Google Benchmark's --benchmark_format=json)
+// or CSV, so runs can be compared across releases.
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    // Keeps the compiler from discarding a value the benchmark computed.
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result
+    {
+        std::string name;
+        std::uint64_t iterations;
+        double nsPerIteration;
+        double itemsPerSecond;   // 0 when the case has no item count
+    };
+
+    class Runner {
+    public:
+        double minTime = 0.2;      // seconds per case
+        std::string filter;        // only run cases whose name contains this
+
+        // Whether run(name, ...) would run the case. Check it before building an
+        // expensive fixture, so a --filter run doesn't pay for skipped cases.
+        bool enabled(const std::string& name) const
+        {
+            return filter.empty() || name.find(filter) != std::string::npos;
+        }
+
+        // fn(iterations) runs the measured work `iterations` times.
+        // itemsPerIteration is used for the throughput column (e.g. bodies or queries).
+        void run(const std::string& name, std::uint64_t itemsPerIteration,
+                 const std::function<void(std::uint64_t)>& fn)
+        {
+            if (!enabled(name))
+                return;
+
+            fn(1); // warm-up (first-touch allocations, tree pools, caches)
+
+            std::uint64_t iterations = 1;
+            double seconds = 0.0;
+            while (true)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                fn(iterations);
+                seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (seconds >= minTime || iterations >= (1ull << 40))
+                    break;
+                // aim a little past minTime, growing at most 10x per round
+                const double scale = seconds > 0.0 ? 1.4 * minTime / seconds : 10.0;
+                const auto next = static_cast<std::uint64_t>(iterations * (scale < 10.0 ? scale : 10.0));
+                iterations = next > iterations ? next : iterations + 1;
+            }
+
+            Result r;
+            r.name = name;
+            r.iterations = iterations;
+            r.nsPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+            r.itemsPerSecond = itemsPerIteration
+                             ? static_cast<double>(itemsPerIteration) * iterations / seconds : 0.0;
+            results.push_back(r);
+
+            std::cout << std::left << std::setw(48) << r.name << std::right
+                      << std::setw(16) << std::fixed << std::setprecision(1) << r.nsPerIteration << " ns"
+                      << std::setw(12) << r.iterations;
+            if (r.itemsPerSecond > 0.0)
+                std::cout << std::setw(14) << std::scientific << std::setprecision(3) << r.itemsPerSecond << " items/s";
+            std::cout << std::defaultfloat << std::endl;
+        }
+
+        bool writeJson(const std::string& path, const std::string& contextJson) const
+        {
+            std::ofstream out(path);
+            if (!out) return false;
+            out << "{\n  \"context\": " << contextJson << ",\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const Result& r = results[i];
+                out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                    << ", \"real_time\": " << std::setprecision(10) << r.nsPerIteration
+                    << ", \"time_unit\": \"ns\"";
+                if (r.itemsPerSecond > 0.0)
+                    out << ", \"items_per_second\": " << r.itemsPerSecond;
+                out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+            out << "  ]\n}\n";
+            return static_cast<bool>(out);
+        }
+
+        bool writeCsv(const std::string& path) const
+        {
+            std::ofstream out(path);
+            if (!out) return false;
+            out << "name,iterations,real_time_ns,items_per_second\n";
+            out << std::setprecision(10);
+            for (const Result& r : results)
+                out << r.name << ',' << r.iterations << ',' << r.nsPerIteration << ',' << r.itemsPerSecond << '\n';
+            return static_cast<bool>(out);
+        }
+
+    private:
+        std::vector<Result> results;
+    };
+
+}
+
+
+#endif //GRAVITY_SIMULATOR_BENCHMARKHARNESS_H
@@ -0,0 +1,443 @@
+// Micro and macro benchmarks for the physics core.
+//
+// usage: gravity_benchmarks [--filter TEXT] [--min-time SECONDS] [--threads N]
+//                           [--json FILE] [--csv FILE]
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkHarness.h"
+
+#include "AtmosphereFactory.h"
+#include "CircleMesh.h"
+#include "DrawList.h"
+#include "GravitySolverFactory.h"
+#include "IntegratorFactory.h"
+#include "Scenarios.h"
+#include "Simulation.h"
+#include "SoftwareRasterizer.h"
+#include "StaticAtmosphere.h"
+#include "StaticDrag.h"
+#include "ThreadPool.h"
+#include "TrailBuffer.h"
+#include "constants.h"
+
+namespace
+{
+    const char* solverName(GravitySolverType type)
+    {
+        switch (type) {
+            case GravitySolverType::DirectSum:          return "DirectSum";
+            case GravitySolverType::SymmetricDirectSum: return "SymmetricDirectSum";
+            case GravitySolverType::SimdDirectSum:      return "SimdDirectSum";
+            case GravitySolverType::BarnesHut:          return "BarnesHut";
+        }
+        return "?";
+    }
+
+    // Largest N worth running per solver (the O(N^2) ones get slow quickly).
+    std::size_t maxBodies(GravitySolverType type)
+    {
+        switch (type) {
+            case GravitySolverType::DirectSum:
+            case GravitySolverType::SymmetricDirectSum: return 4096;
+            case GravitySolverType::SimdDirectSum:      return 16384;
+            case GravitySolverType::BarnesHut:          return 65536;
+        }
+        return 0;
+    }
+
+    const GravitySolverType SOLVERS[] = {
+            GravitySolverType::DirectSum,
+            GravitySolverType::SymmetricDirectSum,
+            GravitySolverType::SimdDirectSum,
+            GravitySolverType::BarnesHut,
+    };
+    const std::size_t BODY_COUNTS[] = {256, 1024, 4096, 16384, 65536};
+
+
+    // One force evaluation (all bodies) per iteration.
+    void benchmarkForceKernels(bench::Runner& runner, ThreadPool& pool)
+    {
+        for (GravitySolverType type : SOLVERS)
+        {
+            for (std::size_t n : BODY_COUNTS)
+            {
+                const std::string name = std::string("forces/") + solverName(type) + "/" + std::to_string(n);
+                if (n > maxBodies(type) || !runner.enabled(name)) continue;
+
+                ParticleSystem particles;
+                scenarios::addOrbitingDisk(particles, n - 1);
+                auto solver = GravitySolverFactory::createSolver(type);
+                solver->setThreadPool(&pool);
+                std::vector<float> ax(particles.size()), ay(particles.size());
+
+                runner.run(name, n,
+                           [&](std::uint64_t iterations)
+                           {
+                               for (std::uint64_t k = 0; k < iterations; ++k)
+                               {
+                                   solver->computeAccelerations(particles, ax.data(), ay.data());
+                                   bench::doNotOptimize(ax[0]);
+                               }
+                           });
+            }
+        }
+    }
+
+    // One full Simulation::step (velocity Verlet) per iteration.
+    void benchmarkSteps(bench::Runner& runner, ThreadPool& pool)
+    {
+        for (GravitySolverType type : {GravitySolverType::SimdDirectSum, GravitySolverType::BarnesHut})
+        {
+            for (std::size_t n : BODY_COUNTS)
+            {
+                const std::string name = std::string("step/") + solverName(type) + "/" + std::to_string(n);
+                if (n > maxBodies(type) || !runner.enabled(name)) continue;
+
+                Simulation simulation(GravitySolverFactory::createSolver(type), &pool,
+                                      IntegratorFactory::createIntegrator(IntegratorType::VelocityVerlet));
+                scenarios::addOrbitingDisk(simulation.particles(), n - 1);
+
+                runner.run(name, n,
+                           [&](std::uint64_t iterations)
+                           {
+                               for (std::uint64_t k = 0; k < iterations; ++k)
+                                   simulation.step(1.0f);
+                               // const access: the mutable particles() would drop the cached forces
+                               bench::doNotOptimize(std::as_const(simulation).particles().x[0]);
+                           });
+            }
+        }
+    }
+
+    // getProperties / getPropertiesBatch over blocks of random altitudes, for the
+    // analytic ISA and its lookup-table version. "random" spans 0-120 km,
+    // "layers" only the layered part of the ISA (0-86 km), where the layer
+    // lookup is hit hardest.
+    void benchmarkAtmosphere(bench::Runner& runner)
+    {
+        const std::size_t count = 4096;
+        std::mt19937 rng(7);
+        auto randomAltitudes = [&](double top)
+        {
+            std::vector<double> altitudes(count);
+            std::uniform_real_distribution<double> altitude(0.0, top);
+            for (double& h : altitudes) h = altitude(rng);
+            return altitudes;
+        };
+        const std::pair<std::vector<double>, const char*> inputs[] = {
+                {randomAltitudes(120000.0), "random"},
+                {randomAltitudes(86000.0),  "layers"},
+        };
+
+        const std::pair<AtmosphereType, const char*> models[] = {
+                {AtmosphereType::ISA,          "ISA"},
+                {AtmosphereType::TabulatedISA, "TabulatedISA"},
+                {AtmosphereType::US76,         "US76"},
+                {AtmosphereType::SpaceWeather, "SpaceWeather"},
+        };
+
+        for (const auto& model : models)
+        {
+            // building a model (the tabulated one samples its source) only if one of its cases runs
+            const std::string prefix = std::string("atmosphere/") + model.second + "/";
+            bool any = false;
+            for (const char* query : {"getProperties/", "getState/", "getPropertiesBatch/"})
+                for (const auto& input : inputs)
+                    any = any || runner.enabled(prefix + query + input.second);
+            if (!any) continue;
+
+            auto atmosphere = AtmosphereFactory::createAtmosphere(model.first);
+
+            for (const auto& input : inputs)
+            {
+                const std::vector<double>& altitudes = input.first;
+                const std::string suffix = std::string("/") + input.second;
+
+                runner.run(std::string("atmosphere/") + model.second + "/getProperties" + suffix, count,
+                           [&](std::uint64_t iterations)
+                           {
+                               double T, P, rho, sum = 0.0;
+                               for (std::uint64_t k = 0; k < iterations; ++k)
+                                   for (double h : altitudes)
+                                   {
+                                       atmosphere->getProperties(h, T, P, rho);
+                                       sum += rho;
+                                   }
+                               bench::doNotOptimize(sum);
+                           });
+
+                runner.run(std::string("atmosphere/") + model.second + "/getState" + suffix, count,
+                           [&](std::uint64_t iterations)
+                           {
+                               double sum = 0.0;
+                               for (std::uint64_t k = 0; k < iterations; ++k)
+                                   for (double h : altitudes)
+                                       sum += atmosphere->getState(h).speedOfSound;
+                               bench::doNotOptimize(sum);
+                           });
+
+                std::vector<double> T(count), P(count), rho(count);
+                runner.run(std::string("atmosphere/") + model.second + "/getPropertiesBatch" + suffix, count,
+                           [&](std::uint64_t iterations)
+                           {
+                               for (std::uint64_t k = 0; k < iterations; ++k)
+                               {
+                                   atmosphere->getPropertiesBatch(altitudes.data(), count, T.data(), P.data(), rho.data());
+                                   bench::doNotOptimize(rho[0]);
+                               }
+                           });
+            }
+        }
+
+        // the same ISA through the compile-time path (inlined, no virtual call)
+        for (const auto& input : inputs)
+        {
+            const std::vector<double>& altitudes = input.first;
+            runner.run(std::string("atmosphere/StaticISA/getProperties/") + input.second, count,
+                       [&](std::uint64_t iterations)
+                       {
+                           double T, P, rho, sum = 0.0;
+                           for (std::uint64_t k = 0; k < iterations; ++k)
+                               for (double h : altitudes)
+                               {
+                                   StaticISA::getProperties(h, T, P, rho);
+                                   sum += rho;
+                               }
+                           bench::doNotOptimize(sum);
+                       });
+        }
+    }
+
+    // One drag pass over the disk around body 0, moved into a 0-120 km shell
+    // above its surface (1 px = 100 km, so the plain disk is all vacuum),
+    // through the virtual batch query (AtmosphericDrag) and the compile-time
+    // model (StaticDrag).
+    void benchmarkDrag(bench::Runner& runner, ThreadPool& pool)
+    {
+        const std::size_t n = 65536;
+        const std::string runtimeName = "drag/ISA/" + std::to_string(n);
+        const std::string staticName = "drag/StaticISA/" + std::to_string(n);
+        if (!runner.enabled(runtimeName) && !runner.enabled(staticName))
+            return;
+
+        ParticleSystem particles;
+        scenarios::addOrbitingDisk(particles, n - 1);
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> altitude(0.0f, 1.2f);   // px
+        for (std::size_t i = 1; i < particles.size(); ++i)
+        {
+            const float dx = particles.x[i] - particles.x[0];
+            const float dy = particles.y[i] - particles.y[0];
+            const float scale = (particles.radius[0] + altitude(rng)) / std::sqrt(dx * dx + dy * dy);
+            particles.x[i] = particles.x[0] + dx * scale;
+            particles.y[i] = particles.y[0] + dy * scale;
+        }
+        std::vector<float> ax(particles.size()), ay(particles.size());
+
+        const AtmosphericDrag runtimeDrag(AtmosphereFactory::createAtmosphere(AtmosphereType::ISA), 0);
+        const StaticIsaDrag staticDrag(0);
+        const std::pair<const AtmosphericDrag*, const std::string*> cases[] = {
+                {&runtimeDrag, &runtimeName},
+                {&staticDrag,  &staticName},
+        };
+
+        for (const auto& c : cases)
+            runner.run(*c.second, n,
+                       [&](std::uint64_t iterations)
+                       {
+                           for (std::uint64_t k = 0; k < iterations; ++k)
+                           {
+                               c.first->addAccelerations(particles, ax.data(), ay.data(), &pool);
+                               bench::doNotOptimize(ax[1]);
+                           }
+                       });
+    }
+
+    // Circle tessellation as done by the viewer for every body (res = 100).
+    void benchmarkTessellation(bench::Runner& runner)
+    {
+        for (int res : {16, 100})
+        {
+            const std::string name = "tessellateCircle/" + std::to_string(res);
+            if (!runner.enabled(name)) continue;
+
+            std::vector<Vec2> fan;
+            fan.reserve(res + 2);
+            runner.run(name, 1,
+                       [&](std::uint64_t iterations)
+                       {
+                           for (std::uint64_t k = 0; k < iterations; ++k)
+                           {
+                               tessellateCircle({700.0f, 500.0f}, 20.0f, res, fan);
+                               bench::doNotOptimize(fan[1]);
+                           }
+                       });
+        }
+    }
+
+    // Filling the per-frame instance list the viewer uploads in one go
+    // (culling + level of detail), at the default view and zoomed out 4x so
+    // every disk body collapses to a point.
+    void benchmarkDrawList(bench::Runner& runner)
+    {
+        const std::size_t n = 100000;
+        const std::pair<float, const char*> zooms[] = {{1.0f, "view"}, {0.25f, "zoomedOut"}};
+        auto name = [&](const char* zoom) { return std::string("drawList/addBodies/") + zoom + "/" + std::to_string(n); };
+        if (!runner.enabled(name(zooms[0].second)) && !runner.enabled(name(zooms[1].second)))
+            return;
+
+        ParticleSystem particles;
+        scenarios::addOrbitingDisk(particles, n - 1);
+
+        for (const auto& zoom : zooms)
+        {
+            if (!runner.enabled(name(zoom.second))) continue;
+
+            DrawList list;
+            ViewTransform view(constants::screenWidth, constants::screenHeight);
+            view.zoomAbout(zoom.first, constants::screenWidth / 2, constants::screenHeight / 2);
+            list.setView(view);
+
+            runner.run(name(zoom.second), n,
+                       [&](std::uint64_t iterations)
+                       {
+                           for (std::uint64_t k = 0; k < iterations; ++k)
+                           {
+                               list.clear();
+                               list.addBodies(particles);
+                               bench::doNotOptimize(list.pointCount());
+                           }
+                       });
+        }
+    }
+
+    // Recording one sample of 100k bodies into their trails, and turning the
+    // trails into draw-list strips.
+    void benchmarkTrails(bench::Runner& runner, ThreadPool& pool)
+    {
+        const std::size_t n = 100000;
+        const std::string recordName = "trails/record/" + std::to_string(n);
+        const std::string addToName = "trails/addTo/" + std::to_string(n);
+        // the 40 Barnes-Hut steps below are the expensive part, skip them when filtered out
+        if (!runner.enabled(recordName) && !runner.enabled(addToName))
+            return;
+
+        Simulation simulation(GravitySolverFactory::createSolver(GravitySolverType::BarnesHut), &pool,
+                              IntegratorFactory::createIntegrator(IntegratorType::VelocityVerlet));
+        ParticleSystem& particles = simulation.particles();
+        scenarios::addOrbitingDisk(particles, n - 1);
+        TrailBuffer trails;
+        // fill the rings with a few real steps first
+        for (int k = 0; k < 40; ++k)
+        {
+            simulation.step(1.0f);
+            trails.record(particles.x.data(), particles.y.data(), particles.size(), &pool);
+        }
+
+        runner.run(recordName, n,
+                   [&](std::uint64_t iterations)
+                   {
+                       for (std::uint64_t k = 0; k < iterations; ++k)
+                           trails.record(particles.x.data(), particles.y.data(), particles.size(), &pool);
+                       bench::doNotOptimize(trails.length(0));
+                   });
+
+        DrawList list;
+        list.setView(ViewTransform(constants::screenWidth, constants::screenHeight));
+        runner.run(addToName, n,
+                   [&](std::uint64_t iterations)
+                   {
+                       for (std::uint64_t k = 0; k < iterations; ++k)
+                       {
+                           list.clear();
+                           trails.addTo(list, COLOR_WHITE);
+                           bench::doNotOptimize(list.lineVertices().size());
+                       }
+                   });
+    }
+
+    // One CPU-rendered frame of the disk at the viewer's window size.
+    void benchmarkRasterizer(bench::Runner& runner, ThreadPool& pool)
+    {
+        for (std::size_t n : {std::size_t(1000), std::size_t(100000)})
+        {
+            const std::string name = "rasterize/" + std::to_string(n);
+            if (!runner.enabled(name)) continue;
+
+            ParticleSystem particles;
+            scenarios::addOrbitingDisk(particles, n - 1);
+            DrawList list;
+            list.setView(ViewTransform(constants::screenWidth, constants::screenHeight));
+            list.addBodies(particles);
+            SoftwareRasterizer rasterizer(static_cast<int>(constants::screenWidth),
+                                          static_cast<int>(constants::screenHeight), &pool);
+
+            runner.run(name, n,
+                       [&](std::uint64_t iterations)
+                       {
+                           for (std::uint64_t k = 0; k < iterations; ++k)
+                           {
+                               rasterizer.draw(list);
+                               bench::doNotOptimize(rasterizer.framebuffer().pixels[0]);
+                           }
+                       });
+        }
+    }
+}
+
+
+
+int main(int argc, char** argv) {
+
+    bench::Runner runner;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string jsonPath, csvPath;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string arg = argv[i];
+        const std::string value = argv[i + 1];
+        if (arg == "--filter")          runner.filter = value;
+        else if (arg == "--min-time")   runner.minTime = std::strtod(value.c_str(), nullptr);
+        else if (arg == "--threads")    threads = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--json")       jsonPath = value;
+        else if (arg == "--csv")        csvPath = value;
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool pool(threads);
+    std::cout << "gravity_benchmarks on " << pool.size() << " threads" << std::endl;
+
+    benchmarkForceKernels(runner, pool);
+    benchmarkSteps(runner, pool);
+    benchmarkAtmosphere(runner);
+    benchmarkDrag(runner, pool);
+    benchmarkTessellation(runner);
+    benchmarkDrawList(runner);
+    benchmarkTrails(runner, pool);
+    benchmarkRasterizer(runner, pool);
+
+    std::ostringstream context;
+    context << "{\"threads\": " << pool.size() << ", \"min_time\": " << runner.minTime << "}";
+
+    if (!jsonPath.empty() && !runner.writeJson(jsonPath, context.str())) {
+        std::cerr << "cannot write " << jsonPath << std::endl;
+        return 1;
+    }
+    if (!csvPath.empty() && !runner.writeCsv(csvPath)) {
+        std::cerr << "cannot write " << csvPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <string>
 #include "atmosphere.h"
 #include "constants.h"
 
@@ -9,6 +10,9 @@
 class AtmosphereFactory {
 public:
     static std::unique_ptr<Atmosphere> createAtmosphere(AtmosphereType type);
+    // SpaceWeather fed from a CSV of indices (SpaceWeatherTable::loadCsv);
+    // an empty path gives the default constant activity. Other types take no file.
+    static std::unique_ptr<Atmosphere> createAtmosphere(AtmosphereType type, const std::string& spaceWeatherCsv);
 
 };
 
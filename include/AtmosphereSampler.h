@@ -0,0 +1,44 @@
+#ifndef GRAVITY_SIMULATOR_ATMOSPHERESAMPLER_H
+#define GRAVITY_SIMULATOR_ATMOSPHERESAMPLER_H
+
+#include <cstdint>
+#include <limits>
+#include "atmosphere.h"
+
+// Per-caller memo in front of an Atmosphere: remembers the last altitude and
+// its state, so asking again for the same altitude (e.g. drag, heating and Mach
+// lookups for one body within one step) costs a compare instead of a model
+// evaluation. The memo also records the model's generation(), so it is
+// dropped automatically once a time-varying model has been advanceTo()'d.
+// Each caller / thread owns its own sampler, so there is no shared mutable
+// state in the model itself.
+class AtmosphereSampler {
+public:
+    explicit AtmosphereSampler(const Atmosphere& model) : model(&model) {}
+
+    const AtmosphereState& at(double altitudeMeters)
+    {
+        const std::uint64_t generation = model->generation();
+        if (altitudeMeters != lastAltitude || generation != lastGeneration)
+        {
+            last = model->getState(altitudeMeters);
+            lastAltitude = altitudeMeters;
+            lastGeneration = generation;
+        }
+        return last;
+    }
+
+    // forget the memo
+    void reset() { lastAltitude = std::numeric_limits<double>::quiet_NaN(); }
+
+    const Atmosphere& atmosphere() const { return *model; }
+
+private:
+    const Atmosphere* model;
+    double lastAltitude = std::numeric_limits<double>::quiet_NaN(); // NaN never compares equal
+    std::uint64_t lastGeneration = 0;
+    AtmosphereState last;
+};
+
+
+#endif //GRAVITY_SIMULATOR_ATMOSPHERESAMPLER_H
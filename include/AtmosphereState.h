@@ -0,0 +1,44 @@
+#ifndef GRAVITY_SIMULATOR_ATMOSPHERESTATE_H
+#define GRAVITY_SIMULATOR_ATMOSPHERESTATE_H
+
+#include <cmath>
+#include "constants.h"
+
+// Everything the drag / Mach-dependent code needs about the air at one
+// altitude, produced by a single model evaluation (Atmosphere::getState).
+struct AtmosphereState
+{
+    double temperature = 0.0;       // K
+    double pressure = 0.0;          // Pa
+    double density = 0.0;           // kg/m^3
+    double speedOfSound = 0.0;      // m/s
+    double dynamicViscosity = 0.0;  // Pa·s
+};
+
+namespace air
+{
+    constexpr double GAMMA = 1.4;                 // ratio of specific heats, dry air
+    // Sutherland's law mu = C1 * T^1.5 / (T + S)
+    constexpr double SUTHERLAND_C1 = 1.458e-6;    // kg/(m·s·K^0.5)
+    constexpr double SUTHERLAND_S  = 110.4;       // K
+
+    // Derived quantities from T, P, rho: a = sqrt(gamma R_AIR T), Sutherland viscosity.
+    // T^1.5 is written as T*sqrt(T) so no pow is needed.
+    inline AtmosphereState makeState(double temperature, double pressure, double density)
+    {
+        AtmosphereState state;
+        state.temperature = temperature;
+        state.pressure = pressure;
+        state.density = density;
+        if (temperature > 0.0)
+        {
+            const double rootT = std::sqrt(temperature);
+            state.speedOfSound = std::sqrt(GAMMA * constants::R_AIR) * rootT;
+            state.dynamicViscosity = SUTHERLAND_C1 * temperature * rootT / (temperature + SUTHERLAND_S);
+        }
+        return state;
+    }
+}
+
+
+#endif //GRAVITY_SIMULATOR_ATMOSPHERESTATE_H
@@ -0,0 +1,130 @@
+#ifndef GRAVITY_SIMULATOR_ATMOSPHERICDRAG_H
+#define GRAVITY_SIMULATOR_ATMOSPHERICDRAG_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include "ParticleSystem.h"
+#include "ThreadPool.h"
+#include "atmosphere.h"
+#include "constants.h"
+
+// Atmospheric drag around one central body (e.g. the Earth):
+//   a = -1/2 * rho * Cd * A * |v_rel| * v_rel / m
+// rho   - density from the atmosphere model at the body's altitude above the
+//         central body's surface (distance between centres minus its radius)
+// Cd    - per body (ParticleSystem::dragCoefficient)
+// A     - pi * radius^2, the body's cross-section from ParticleSystem::radius
+// v_rel - velocity relative to the central body (no co-rotating atmosphere)
+// Pixels, ticks and the scaled units are converted to SI with
+// constants::DISTANCE_SCALE / VELOCITY_SCALE.
+//
+// The per-body loop runs on the thread pool, altitudes are passed to the
+// model in chunks through getPropertiesBatch (one virtual call per chunk),
+// and every body only writes its own acceleration. StaticDrag (StaticDrag.h)
+// runs the same loop against a compile-time model instead.
+class AtmosphericDrag {
+public:
+    explicit AtmosphericDrag(std::unique_ptr<Atmosphere> atmosphere, std::size_t centralBody = 0);
+    virtual ~AtmosphericDrag() = default;
+
+    // ax/ay += drag acceleration of every body except the central one
+    virtual void addAccelerations(const ParticleSystem& bodies, float* ax, float* ay, ThreadPool* pool) const;
+
+    Atmosphere& atmosphere() { return *model; }
+    const Atmosphere& atmosphere() const { return *model; }
+
+    std::size_t centralBody() const { return central; }
+    void setCentralBody(std::size_t index) { central = index; }
+
+protected:
+    // The drag loop with the density source as a parameter:
+    // query(altitudes, count, T, P, rho) fills one chunk of at most CHUNK
+    // altitudes. Called with a virtual batch query here, with a direct,
+    // inlinable one by StaticDrag.
+    template <typename Query>
+    void addAccelerationsWith(const ParticleSystem& bodies, float* ax, float* ay, ThreadPool* pool,
+                              const Query& query) const;
+
+private:
+    // altitudes per density query (scratch lives on the stack)
+    static constexpr std::size_t CHUNK = 256;
+
+    std::unique_ptr<Atmosphere> model;
+    std::size_t central;
+};
+
+//------------------------------------------------------------------------------
+template <typename Query>
+void AtmosphericDrag::addAccelerationsWith(const ParticleSystem& bodies, float* ax, float* ay, ThreadPool* pool,
+                                           const Query& query) const
+{
+    const std::size_t n = bodies.size();
+    if (central >= n)
+        return;
+
+    const float* x = bodies.x.data();
+    const float* y = bodies.y.data();
+    const float* vx = bodies.vx.data();
+    const float* vy = bodies.vy.data();
+    const float* mass = bodies.mass.data();
+    const float* radius = bodies.radius.data();
+    const float* cd = bodies.dragCoefficient.data();
+
+    const double cx = x[central];
+    const double cy = y[central];
+    const double cvx = vx[central];
+    const double cvy = vy[central];
+    const double surface = radius[central];
+
+    // a [px/tick^2] equals a [m/s^2] in this unit system (see constants.h), so
+    // the SI formula only needs the area and speed in metres:
+    //   a = -0.5 * rho * Cd * pi * (r*DISTANCE_SCALE)^2 * VELOCITY_SCALE^2 * |v| * v / m
+    const double scale = 0.5 * PI * constants::DISTANCE_SCALE * constants::DISTANCE_SCALE
+                         * constants::VELOCITY_SCALE * constants::VELOCITY_SCALE;
+    const std::size_t skip = central;
+
+    parallelFor(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        double altitude[CHUNK];
+        double T[CHUNK], P[CHUNK], rho[CHUNK];
+
+        for (std::size_t start = begin; start < end; start += CHUNK)
+        {
+            const std::size_t count = std::min(CHUNK, end - start);
+
+            // 1) altitude above the central body's surface, in metres
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                const std::size_t i = start + k;
+                const double dx = x[i] - cx;
+                const double dy = y[i] - cy;
+                altitude[k] = (std::sqrt(dx * dx + dy * dy) - surface) * constants::DISTANCE_SCALE;
+            }
+
+            // 2) one density query per chunk
+            query(altitude, count, T, P, rho);
+
+            // 3) drag against the velocity relative to the central body
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                const std::size_t i = start + k;
+                if (i == skip || rho[k] <= 0.0)
+                    continue;
+
+                const double rvx = vx[i] - cvx;
+                const double rvy = vy[i] - cvy;
+                const double speed = std::sqrt(rvx * rvx + rvy * rvy);
+                const double r = radius[i];
+                const double factor = -scale * rho[k] * cd[i] * r * r * speed / mass[i];
+
+                ax[i] += static_cast<float>(factor * rvx);
+                ay[i] += static_cast<float>(factor * rvy);
+            }
+        }
+    });
+}
+
+
+#endif //GRAVITY_SIMULATOR_ATMOSPHERICDRAG_H
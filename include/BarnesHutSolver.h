@@ -0,0 +1,45 @@
+#ifndef GRAVITY_SIMULATOR_BARNESHUTSOLVER_H
+#define GRAVITY_SIMULATOR_BARNESHUTSOLVER_H
+
+#include <vector>
+#include "GravitySolver.h"
+
+// Barnes–Hut approximation: the bodies are sorted into a quadtree every step
+// and distant groups are replaced by their centre of mass. A cell of width s
+// at distance d is used as a single pseudo-body when s/d < theta, so theta = 0
+// degenerates to the direct sum and larger values trade accuracy for speed.
+class BarnesHutSolver: public GravitySolver {
+public:
+    explicit BarnesHutSolver(float theta = 0.5f);
+    virtual ~BarnesHutSolver() = default;
+
+    void computeAccelerations(const ParticleSystem& particles,
+                              float* ax,
+                              float* ay) override;
+
+    void setTheta(float theta) { this->theta = theta; }
+    float getTheta() const { return theta; }
+
+private:
+    struct Node
+    {
+        float cx, cy;       // cell centre
+        float halfSize;     // half of the (square) cell width
+        float mass;         // total mass in the cell
+        float comX, comY;   // centre of mass (weighted sum while building)
+        int firstChild;     // index of 4 consecutive children, -1 for a leaf
+        int body;           // body held by a leaf (-1 empty, -2 several lumped bodies)
+    };
+
+    void buildTree(const ParticleSystem& particles);
+    void insertBody(const ParticleSystem& particles, int body);
+    int childFor(const Node& node, float px, float py) const;
+    void subdivide(int nodeIndex);
+    void accelerationOn(const ParticleSystem& particles, int body, float& ax, float& ay) const;
+
+    float theta;
+    std::vector<Node> nodes;   // reused between steps, so rebuilding does not allocate
+};
+
+
+#endif //GRAVITY_SIMULATOR_BARNESHUTSOLVER_H
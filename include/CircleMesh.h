@@ -0,0 +1,41 @@
+#ifndef GRAVITY_SIMULATOR_CIRCLEMESH_H
+#define GRAVITY_SIMULATOR_CIRCLEMESH_H
+
+#include <vector>
+#include "Vec2.h"
+
+// Triangle-fan outline of a circle: the centre followed by res+1 rim points
+// (the first rim point is repeated at the end to close the fan). Pure
+// geometry, so the viewer, the benchmarks and any offscreen renderer share it.
+void tessellateCircle(Vec2 centre, float radius, int res, std::vector<Vec2>& fan);
+
+
+// Circle levels of detail, coarse to fine. A body is drawn with the coarsest
+// level whose rim stays within CIRCLE_LOD_TOLERANCE pixels of the true circle
+// at its on-screen radius; bodies smaller than CIRCLE_POINT_RADIUS pixels are
+// drawn as single points instead.
+inline constexpr int CIRCLE_LOD_LEVELS = 5;
+inline constexpr int CIRCLE_LOD_SEGMENTS[CIRCLE_LOD_LEVELS] = {8, 16, 32, 64, 128};
+inline constexpr float CIRCLE_LOD_TOLERANCE = 0.25f;   // pixels
+inline constexpr float CIRCLE_POINT_RADIUS = 0.5f;     // pixels
+
+// Largest on-screen radius a level with n segments covers. The rim of an
+// n-gon is off by r (1 - cos(pi/n)) <= r pi^2 / (2 n^2), so this bound is
+// slightly conservative.
+constexpr float circleLodMaxRadius(int segments)
+{
+    return 2.0f * CIRCLE_LOD_TOLERANCE * segments * segments / (3.14159265f * 3.14159265f);
+}
+
+// Level of detail for a circle of pixelRadius on screen (the finest level
+// for anything larger than it covers).
+inline int circleLodLevel(float pixelRadius)
+{
+    int level = 0;
+    while (level < CIRCLE_LOD_LEVELS - 1 && pixelRadius > circleLodMaxRadius(CIRCLE_LOD_SEGMENTS[level]))
+        ++level;
+    return level;
+}
+
+
+#endif //GRAVITY_SIMULATOR_CIRCLEMESH_H
@@ -0,0 +1,56 @@
+#ifndef GRAVITY_SIMULATOR_CIRCLERENDERER_H
+#define GRAVITY_SIMULATOR_CIRCLERENDERER_H
+
+#include <vector>
+#include "CircleMesh.h"
+#include "DrawList.h"
+#include "Vec2.h"
+
+// Draws every circle of a DrawList. Part of the viewer target only; the
+// physics core never touches OpenGL.
+//
+// With OpenGL 3.3 available it keeps one unit-circle triangle fan per level of
+// detail in a VBO, streams the DrawList's instance records into a second
+// buffer once per frame and issues one glDrawArraysInstanced per non-empty
+// level, plus one for the sub-pixel points. Otherwise (no GL 3.3, shader
+// compile failure) it falls back to immediate mode, still reusing the
+// precomputed unit circles instead of calling cos/sin per vertex.
+class CircleRenderer {
+public:
+    CircleRenderer();
+    ~CircleRenderer();
+
+    CircleRenderer(const CircleRenderer&) = delete;
+    CircleRenderer& operator=(const CircleRenderer&) = delete;
+
+    // Needs a current GL context (and glewInit() done). Returns whether the
+    // instanced path is in use.
+    bool init();
+
+    // uses the list's view transform; the viewport is its width x height
+    void draw(const DrawList& list);
+
+    bool instanced() const { return useInstancing; }
+
+private:
+    void drawInstances(unsigned int mode, int first, int count,
+                       std::size_t byteOffset, std::size_t instances);
+    void drawImmediate(const DrawList& list);
+    void release();
+
+    // unit fans of every level back to back, centre first
+    std::vector<Vec2> unitFans;
+    int fanFirst[CIRCLE_LOD_LEVELS] = {};
+    int fanCount[CIRCLE_LOD_LEVELS] = {};
+
+    bool useInstancing = false;
+    unsigned int program = 0;
+    unsigned int vao = 0;
+    unsigned int meshBuffer = 0;
+    unsigned int instanceBuffer = 0;
+    std::size_t instanceCapacity = 0;   // in instances
+    int transformLocation = -1;
+};
+
+
+#endif //GRAVITY_SIMULATOR_CIRCLERENDERER_H
@@ -0,0 +1,19 @@
+#ifndef GRAVITY_SIMULATOR_DIRECTSUMSOLVER_H
+#define GRAVITY_SIMULATOR_DIRECTSUMSOLVER_H
+
+#include "GravitySolver.h"
+
+// Exact O(N^2) sum over every pair of bodies. Slow for large N, but it is the
+// reference the approximate solvers are checked against.
+class DirectSumSolver: public GravitySolver {
+public:
+    DirectSumSolver() = default;
+    virtual ~DirectSumSolver() = default;
+
+    void computeAccelerations(const ParticleSystem& particles,
+                              float* ax,
+                              float* ay) override;
+};
+
+
+#endif //GRAVITY_SIMULATOR_DIRECTSUMSOLVER_H
@@ -0,0 +1,99 @@
+#ifndef GRAVITY_SIMULATOR_DRAWLIST_H
+#define GRAVITY_SIMULATOR_DRAWLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CircleMesh.h"
+#include "Vec2.h"
+#include "ViewTransform.h"
+
+class ParticleSystem;
+struct SimulationSnapshot;
+
+// RGBA8 packed so the bytes in memory are R, G, B, A (what the GPU instance
+// attribute and the software rasteriser both read).
+constexpr std::uint32_t packColor(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255)
+{
+    return static_cast<std::uint32_t>(r) | (static_cast<std::uint32_t>(g) << 8)
+           | (static_cast<std::uint32_t>(b) << 16) | (static_cast<std::uint32_t>(a) << 24);
+}
+
+constexpr std::uint32_t COLOR_WHITE = packColor(255, 255, 255);
+
+// One filled circle, laid out exactly as a GPU instance record (16 bytes).
+struct CircleInstance
+{
+    float x;
+    float y;
+    float radius;
+    std::uint32_t color;
+};
+static_assert(sizeof(CircleInstance) == 16, "CircleInstance is uploaded as-is");
+
+// A polyline (e.g. a body's trail): count consecutive points of the list's
+// line vertices, starting at first.
+struct LineStrip
+{
+    std::uint32_t first;
+    std::uint32_t count;
+    std::uint32_t color;
+};
+
+// What to draw this frame, in world (pixel) coordinates, independent of any
+// graphics API. The simulation side fills it; a renderer (instanced OpenGL in
+// the viewer, or anything else) consumes it in one go. The storage is kept
+// between frames, so refilling it does not allocate once it has grown.
+//
+// Circles are sorted by their size on screen under the current view while
+// they are added: anything entirely outside the viewport is dropped, bodies
+// under a pixel go to the point list, and the rest are bucketed by level of
+// detail (see circleLodLevel), so a renderer spends vertices only where they
+// show. Line strips are kept whole unless they lie entirely off the viewport.
+// Renderers draw the lines first, then the circles, then the points. Set the
+// view before adding.
+class DrawList {
+public:
+    void setView(const ViewTransform& view) { currentView = view; }
+    const ViewTransform& view() const { return currentView; }
+
+    void clear();
+
+    void addCircle(float x, float y, float radius, std::uint32_t color = COLOR_WHITE);
+    // one circle per body
+    void addBodies(const ParticleSystem& bodies, std::uint32_t color = COLOR_WHITE);
+    // one circle per body of a published step, placed blend (0..1) of the way
+    // from its start to its end positions
+    void addBodies(const SimulationSnapshot& snapshot, float blend, std::uint32_t color = COLOR_WHITE);
+
+    // world-space polyline of count points (fewer than two draws nothing)
+    void addLineStrip(const Vec2* points, std::size_t count, std::uint32_t color = COLOR_WHITE);
+    // the same, given in two pieces (a then b), e.g. the halves of a ring buffer
+    void addLineStrip(const Vec2* a, std::size_t countA, const Vec2* b, std::size_t countB,
+                      std::uint32_t color = COLOR_WHITE);
+
+    // circles to draw with CIRCLE_LOD_SEGMENTS[level] segments
+    const std::vector<CircleInstance>& circleInstances(int level) const { return circles[level]; }
+    // sub-pixel bodies, one point each (radius kept for renderers that want it)
+    const std::vector<CircleInstance>& pointInstances() const { return points; }
+
+    const std::vector<Vec2>& lineVertices() const { return vertices; }
+    const std::vector<LineStrip>& lineStrips() const { return strips; }
+
+    std::size_t circleCount() const;
+    std::size_t pointCount() const { return points.size(); }
+    std::size_t culledCount() const { return culled; }
+
+private:
+    void classify(const CircleInstance& c);
+
+    ViewTransform currentView;
+    std::vector<CircleInstance> circles[CIRCLE_LOD_LEVELS];
+    std::vector<CircleInstance> points;
+    std::vector<Vec2> vertices;
+    std::vector<LineStrip> strips;
+    std::size_t culled = 0;
+};
+
+
+#endif //GRAVITY_SIMULATOR_DRAWLIST_H
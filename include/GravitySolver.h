@@ -0,0 +1,30 @@
+//Abstract class for the gravity (force) solvers
+
+#ifndef GRAVITY_SIMULATOR_GRAVITYSOLVER_H
+#define GRAVITY_SIMULATOR_GRAVITYSOLVER_H
+
+class ParticleSystem;
+class ThreadPool;
+
+class GravitySolver {
+public:
+    virtual ~GravitySolver() = default;
+
+    // Writes the gravitational acceleration of every body into ax/ay
+    // (both sized particles.size()). Positions are only read, so every body
+    // sees the same frozen state of the system.
+    virtual void computeAccelerations(const ParticleSystem& particles,
+                                      float* ax,
+                                      float* ay) = 0;
+
+    // Optional worker pool for the per-body loops (nullptr = single thread).
+    // Each body's acceleration is still summed in a fixed order, so the
+    // result does not depend on the number of threads.
+    void setThreadPool(ThreadPool* pool) { this->pool = pool; }
+
+protected:
+    ThreadPool* pool = nullptr;
+};
+
+
+#endif //GRAVITY_SIMULATOR_GRAVITYSOLVER_H
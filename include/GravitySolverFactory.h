@@ -0,0 +1,16 @@
+#include <memory>
+#include "GravitySolver.h"
+#include "constants.h"
+
+#ifndef GRAVITY_SIMULATOR_GRAVITYSOLVERFACTORY_H
+#define GRAVITY_SIMULATOR_GRAVITYSOLVERFACTORY_H
+
+
+class GravitySolverFactory {
+public:
+    static std::unique_ptr<GravitySolver> createSolver(GravitySolverType type);
+
+};
+
+
+#endif //GRAVITY_SIMULATOR_GRAVITYSOLVERFACTORY_H
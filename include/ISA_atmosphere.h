@@ -2,7 +2,7 @@
 #define GRAVITY_SIMULATOR_ISA_ATMOSPHERE_H
 
 
-#include "Atmosphere.h"
+#include "atmosphere.h"
 
 static constexpr double L0   = 0.0065;     //K/m, tropospheric lapse
 static constexpr double Tropo_grad =-0.0065;
@@ -20,6 +20,14 @@ public:
                        double &temperature,
                        double &pressure,
                        double &density) const override;
+
+    AtmosphereState getState(double altitudeMeters) const override;
+
+    void getPropertiesBatch(const double* altitudes,
+                            std::size_t count,
+                            double* temperature,
+                            double* pressure,
+                            double* density) const override;
 private:
     void computeISAProperties(double altitudeMeters,
                               double &temperature,
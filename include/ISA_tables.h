@@ -0,0 +1,190 @@
+#ifndef GRAVITY_SIMULATOR_ISA_TABLES_H
+#define GRAVITY_SIMULATOR_ISA_TABLES_H
+
+#include <cmath>
+
+// The ISA (US Standard Atmosphere 1976 up to 86 km, isothermal extension to
+// 1000 km, vacuum above) as compile-time tables plus an inline evaluation.
+// Shared by ISA_atmosphere (runtime / virtual path) and StaticAtmosphere
+// (compile-time path), so both give bit-identical results.
+namespace isa
+{
+    // Physical constants
+    inline constexpr double G0 = 9.80665;       // m/s^2
+    inline constexpr double R  = 287.053;       // J/(kg·K) for dry air
+
+    // Sea-level reference
+    inline constexpr double SEA_LEVEL_TEMP   = 288.15;   // K
+    inline constexpr double SEA_LEVEL_PRESS  = 101325.0; // Pa
+    inline constexpr double SEA_LEVEL_DENS   = 1.225;    // kg/m^3
+
+    // For the 1976 Standard Atmosphere up to ~86 km, we define discrete layers:
+    //   hBase (m), tBase (K), pBase (Pa), lapseRate (K/m)
+    struct AtmosphereLayer
+    {
+        double hBase;     // layer base altitude, in [m]
+        double tBase;     // temperature at base, in [K]
+        double pBase;     // pressure at base, in [Pa]
+        double lapseRate; // [K/m]
+    };
+
+    // Typically the standard atmosphere is segmented as:
+    //   0–11 km, 11–20 km, 20–32 km, 32–47 km, 47–51 km, 51–71 km, 71–86 km
+    // The data below is approximate and can be refined as needed.
+    inline constexpr AtmosphereLayer LAYERS[] = {
+            // hBase,   tBase,  pBase,    lapseRate
+            {   0.0,   288.15, 101325.0, -0.0065   },  //  0–11 km
+            {11000.0,  216.65, 22632.10,  0.0      },  // 11–20 km
+            {20000.0,  216.65, 5474.89,   0.0010   },  // 20–32 km
+            {32000.0,  228.65, 868.019,   0.0028   },  // 32–47 km
+            {47000.0,  270.65, 110.906,   0.0      },  // 47–51 km
+            {51000.0,  270.65, 66.9389,  -0.0028   },  // 51–71 km
+            {71000.0,  214.65, 3.95642,  -0.0020   }   // 71–86 km (approx)
+    };
+    inline constexpr int NUM_LAYERS = sizeof(LAYERS) / sizeof(LAYERS[0]);
+
+    // The top of our known piecewise layers is about 86 km (the last layer’s hBase is ~71 km,
+    // so effectively we handle up to ~86 km). Above that, we can do a simple isothermal or
+    // exponential extension. For example:
+    inline constexpr double EXTEND_TOP_ALTITUDE = 86000.0; // 86 km
+    // Temperature at 86 km (extrapolate or approximate):
+    // We can sample the last layer if you prefer.
+    // We'll pick T ~ 186.87K or so. Let's do an approximate from the last layer.
+    inline constexpr double EXTEND_TOP_TEMP    = 186.95;   // K  (example near 86+ km)
+    // Pressure at 86 km from the last layer formula (approx):
+    inline constexpr double EXTEND_TOP_PRESS   = 0.227;    // Pa  (example, fairly small)
+    // We'll do an isothermal extension from 86 km to 1000 km.
+    // That means:  P(h) = P(86km)*exp[-g0*(h-86km)/(R*T_ext)]
+    // If you want more layers up to 1000 km, insert them similarly.
+
+    // Per-layer constants with the exponents precomputed:
+    // Lapse layers:      P = pBase * (T/tBase) ^ powExponent,  powExponent = -g0/(R*lapse)
+    // Isothermal layers: P = pBase * exp(isoExponent * dh),    isoExponent = -g0/(R*T)
+    // One pseudo-layer is appended for the isothermal extension above 86 km.
+    struct LayerCoefficients
+    {
+        double hBase;
+        double tBase;
+        double pBase;
+        double lapseRate;
+        double powExponent;
+        double isoExponent;
+    };
+
+    constexpr LayerCoefficients makeCoefficients(double hBase, double tBase, double pBase, double lapse)
+    {
+        const bool isothermal = (lapse > -1.0e-15 && lapse < 1.0e-15);
+        return {hBase, tBase, pBase, isothermal ? 0.0 : lapse,
+                isothermal ? 0.0 : -G0 / (R * lapse),
+                isothermal ? -G0 / (R * tBase) : 0.0};
+    }
+
+    inline constexpr int EXTENSION_LAYER = NUM_LAYERS;
+
+    inline constexpr LayerCoefficients COEFFS[] = {
+            makeCoefficients(LAYERS[0].hBase, LAYERS[0].tBase, LAYERS[0].pBase, LAYERS[0].lapseRate),
+            makeCoefficients(LAYERS[1].hBase, LAYERS[1].tBase, LAYERS[1].pBase, LAYERS[1].lapseRate),
+            makeCoefficients(LAYERS[2].hBase, LAYERS[2].tBase, LAYERS[2].pBase, LAYERS[2].lapseRate),
+            makeCoefficients(LAYERS[3].hBase, LAYERS[3].tBase, LAYERS[3].pBase, LAYERS[3].lapseRate),
+            makeCoefficients(LAYERS[4].hBase, LAYERS[4].tBase, LAYERS[4].pBase, LAYERS[4].lapseRate),
+            makeCoefficients(LAYERS[5].hBase, LAYERS[5].tBase, LAYERS[5].pBase, LAYERS[5].lapseRate),
+            makeCoefficients(LAYERS[6].hBase, LAYERS[6].tBase, LAYERS[6].pBase, LAYERS[6].lapseRate),
+            makeCoefficients(EXTEND_TOP_ALTITUDE, EXTEND_TOP_TEMP, EXTEND_TOP_PRESS, 0.0),
+    };
+    static_assert(sizeof(COEFFS) / sizeof(COEFFS[0]) == NUM_LAYERS + 1,
+                  "COEFFS must mirror LAYERS plus the extension band");
+
+    static_assert(LAYERS[0].hBase == 0.0 && LAYERS[0].tBase == SEA_LEVEL_TEMP
+                  && LAYERS[0].pBase == SEA_LEVEL_PRESS,
+                  "the first ISA layer must start at sea level");
+
+    constexpr bool basesIncreasing()
+    {
+        for (int l = 1; l < NUM_LAYERS; ++l)
+            if (!(LAYERS[l].hBase > LAYERS[l - 1].hBase))
+                return false;
+        return LAYERS[NUM_LAYERS - 1].hBase < EXTEND_TOP_ALTITUDE;
+    }
+    static_assert(basesIncreasing(), "ISA layer bases must increase and stay below 86 km");
+
+    // T, P and rho at one altitude, without any diagnostics.
+    inline void evaluate(double altitudeMeters, double& temperature, double& pressure, double& density)
+    {
+        // 1) If altitude < top of known piecewise layers (~86 km), we do the standard steps:
+        if (altitudeMeters < EXTEND_TOP_ALTITUDE)
+        {
+            // find the layer in which altitude falls.
+            // This stays a compare chain on purpose: the compiler unrolls it into a
+            // decision tree with each layer's constants folded in, and its branches
+            // resolve straight from the altitude. A per-km bucket table puts a load
+            // chain in front of the branch on the lapse rate and measured ~25%
+            // slower on random altitudes; a branch-free form (one pow for every
+            // layer) was slower still, since pow costs more than the exp the
+            // isothermal layers need.
+            int layer = NUM_LAYERS - 1;
+            for (int i = 0; i < NUM_LAYERS - 1; ++i)
+            {
+                double nextBase = LAYERS[i+1].hBase;
+                // if the altitude is less than the next layer’s base, we’re in layer i
+                if (altitudeMeters < nextBase)
+                {
+                    layer = i;
+                    break;
+                }
+            }
+
+            const auto &coeffs = COEFFS[layer];   // LAYERS[layer] plus precomputed exponents
+            double hBase   = coeffs.hBase;
+            double tBase   = coeffs.tBase;
+            double pBase   = coeffs.pBase;
+            double lapse   = coeffs.lapseRate; // K/m
+            double dh      = altitudeMeters - hBase; // above this layer's base
+
+            if (std::abs(lapse) > 1.0e-15)
+            {
+                // T = T_base + lapse*(h-h_base)
+                // P = P_base * (T / T_base)^(-g0/(R*lapse))
+                temperature = tBase + lapse * dh;
+                double exponent = coeffs.powExponent;          // -g0/(R*lapse)
+                pressure = pBase * std::pow(temperature / tBase, exponent);
+            }
+            else
+            {
+                // isothermal layer
+                temperature = tBase;
+                double exponent = coeffs.isoExponent * dh;     // -g0*dh/(R*T)
+                pressure = pBase * std::exp(exponent);
+            }
+        }
+            // 2) If altitude >= ~86 km, we do a simplified extension up to 1000 km
+        else if (altitudeMeters <= 1.0e6)  // 1000 km in meters = 1.0e6
+        {
+            // Simple isothermal extension from 86 km to 1000 km
+            // We'll define a constant temperature (EXTEND_TOP_TEMP).
+            // Then: P(h) = P(86km) * exp[-g0*(h - 86km)/(R*T)]
+            // This is quite rough, but fast & simple.
+
+            double dh = altitudeMeters - EXTEND_TOP_ALTITUDE;
+            temperature = EXTEND_TOP_TEMP;
+            double exponent = COEFFS[EXTENSION_LAYER].isoExponent * dh;
+            pressure = EXTEND_TOP_PRESS * std::exp(exponent);
+        }
+        else
+        {
+            // For altitude > 1000 km, treat it as vacuum.
+            // You could keep extending if you truly want 2000 km, 3000 km, etc.
+            // We'll just clamp to near-vacuum:
+            temperature = EXTEND_TOP_TEMP;   // or some fixed outer-space approx
+            pressure    = 0.0;
+        }
+
+        // 3) Density from ideal gas law
+        if (pressure > 0.0 && temperature > 0.0)
+            density = pressure / (R * temperature);
+        else
+            density = 0.0;
+    }
+}
+
+
+#endif //GRAVITY_SIMULATOR_ISA_TABLES_H
@@ -0,0 +1,21 @@
+//Abstract class for the time integrators
+
+#ifndef GRAVITY_SIMULATOR_INTEGRATOR_H
+#define GRAVITY_SIMULATOR_INTEGRATOR_H
+
+class Simulation;
+
+// An integrator advances a Simulation by dt using its building blocks:
+//   computeAccelerations()  - force phase
+//   kick(h)                 - v += a*h
+//   drift(h)                - x += v*h
+// so every scheme gets the parallel, phase-separated passes for free.
+class Integrator {
+public:
+    virtual ~Integrator() = default;
+
+    virtual void step(Simulation& simulation, float dt) = 0;
+};
+
+
+#endif //GRAVITY_SIMULATOR_INTEGRATOR_H
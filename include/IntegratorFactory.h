@@ -0,0 +1,16 @@
+#include <memory>
+#include "Integrator.h"
+#include "constants.h"
+
+#ifndef GRAVITY_SIMULATOR_INTEGRATORFACTORY_H
+#define GRAVITY_SIMULATOR_INTEGRATORFACTORY_H
+
+
+class IntegratorFactory {
+public:
+    static std::unique_ptr<Integrator> createIntegrator(IntegratorType type);
+
+};
+
+
+#endif //GRAVITY_SIMULATOR_INTEGRATORFACTORY_H
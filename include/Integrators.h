@@ -0,0 +1,36 @@
+#ifndef GRAVITY_SIMULATOR_INTEGRATORS_H
+#define GRAVITY_SIMULATOR_INTEGRATORS_H
+
+#include "Integrator.h"
+
+// Semi-implicit Euler (kick then drift): the scheme the original frame loop used.
+// First order; kept for reference and comparisons.
+class EulerIntegrator: public Integrator {
+public:
+    void step(Simulation& simulation, float dt) override;
+};
+
+// Drift-kick-drift leapfrog. Second order and symplectic, one force evaluation per step.
+class LeapfrogIntegrator: public Integrator {
+public:
+    void step(Simulation& simulation, float dt) override;
+};
+
+// Kick-drift-kick velocity Verlet. Second order and symplectic; the accelerations
+// from the end of one step are reused at the start of the next, so this also
+// costs a single force evaluation per step.
+class VelocityVerletIntegrator: public Integrator {
+public:
+    void step(Simulation& simulation, float dt) override;
+};
+
+// Yoshida 4th order: three leapfrog sub-steps with the classic w0/w1 weights.
+// Three force evaluations per step, but the error drops so fast with dt that it
+// usually wins when high accuracy is needed.
+class Yoshida4Integrator: public Integrator {
+public:
+    void step(Simulation& simulation, float dt) override;
+};
+
+
+#endif //GRAVITY_SIMULATOR_INTEGRATORS_H
@@ -0,0 +1,45 @@
+#ifndef GRAVITY_SIMULATOR_LINERENDERER_H
+#define GRAVITY_SIMULATOR_LINERENDERER_H
+
+#include <vector>
+#include "DrawList.h"
+
+// Draws the line strips of a DrawList (trails). Viewer target only.
+//
+// With OpenGL 3.3 all strip vertices go into one streamed VBO and every run
+// of consecutive strips with the same colour is drawn by one
+// glMultiDrawArrays(GL_LINE_STRIP) - a single call when all trails share a
+// colour. Without GL 3.3 it falls back to one glBegin/glEnd per strip.
+class LineRenderer {
+public:
+    LineRenderer() = default;
+    ~LineRenderer();
+
+    LineRenderer(const LineRenderer&) = delete;
+    LineRenderer& operator=(const LineRenderer&) = delete;
+
+    // Needs a current GL context (and glewInit() done). Returns whether the
+    // batched path is in use.
+    bool init();
+
+    void draw(const DrawList& list);
+
+private:
+    void drawImmediate(const DrawList& list);
+    void release();
+
+    bool useBuffers = false;
+    unsigned int program = 0;
+    unsigned int vao = 0;
+    unsigned int vertexBuffer = 0;
+    std::size_t vertexCapacity = 0;   // in vertices
+    int transformLocation = -1;
+    int colorLocation = -1;
+
+    // per-frame glMultiDrawArrays arguments, kept to avoid reallocating
+    std::vector<int> firsts;
+    std::vector<int> counts;
+};
+
+
+#endif //GRAVITY_SIMULATOR_LINERENDERER_H
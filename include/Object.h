@@ -1,32 +1,50 @@
-#include <vector>
+#include <cstddef>
 #include <cmath>
-
-
-constexpr double PI = 3.141592653589793238462643383279;
+#include "Vec2.h"
 
 #ifndef GRAVITY_SIMULATOR_OBJECT_H
 #define GRAVITY_SIMULATOR_OBJECT_H
 
 
+constexpr double PI = 3.141592653589793238462643383279;
+
+class ParticleSystem;
+
+// Lightweight handle to one body stored in a ParticleSystem.
+// The state itself lives in the system's flat arrays; an Object only keeps
+// the owning system and the body index, so it is cheap to copy and pass around.
+// Drawing lives in the viewer (see CircleRenderer.h).
 class Object {
 
 public:
-    // values
-    std::vector<float> position;
-    std::vector<float> velocity;
-    float radius;
-    double mass;
-
     // constructors
-    Object();
-    Object(std::vector<float> position, std::vector<float> velocity,float mass, float radius);
+    Object(ParticleSystem& system, std::size_t index);
+
+    // accessors (references into the particle arrays)
+    float& x() const;
+    float& y() const;
+    float& vx() const;
+    float& vy() const;
+    float& mass() const;
+    float& radius() const;
+    float& dragCoefficient() const;
+    std::size_t index() const { return idx; }
+
+    Vec2 position() const;
+    Vec2 velocity() const;
+    void setPosition(Vec2 p);
+    void setVelocity(Vec2 v);
 
     //methods
-    void accelerate(float ax, float ay);
-    void updatePos();
-    void DrawCircle(int res);
+    // dt defaults to one tick, the step the original frame loop used
+    void accelerate(Vec2 acceleration, float dt = 1.0f);
+    void updatePos(float dt = 1.0f);
     void checkCollisionWithScreen(float screenWidth, float screenHeight);
 
+private:
+    ParticleSystem* system;
+    std::size_t idx;
+
 };
 
 
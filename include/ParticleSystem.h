@@ -0,0 +1,43 @@
+#ifndef GRAVITY_SIMULATOR_PARTICLESYSTEM_H
+#define GRAVITY_SIMULATOR_PARTICLESYSTEM_H
+
+#include <cstddef>
+#include "AlignedAllocator.h"
+#include "Object.h"
+#include "constants.h"
+
+// Structure-of-arrays store for every body in the simulation.
+// Each property lives in its own contiguous, 64-byte aligned array, so the
+// force, integration and drawing loops stream over flat memory instead of
+// chasing two heap pointers per Object.
+class ParticleSystem {
+
+public:
+    // values (index i describes body i in every array)
+    AlignedVector<float> x;
+    AlignedVector<float> y;
+    AlignedVector<float> vx;
+    AlignedVector<float> vy;
+    AlignedVector<float> mass;
+    AlignedVector<float> radius;
+    AlignedVector<float> dragCoefficient;   // Cd, used when drag is enabled
+
+    // constructors
+    ParticleSystem() = default;
+    explicit ParticleSystem(std::size_t capacity);
+
+    //methods
+    std::size_t addBody(float px, float py, float pvx, float pvy, float m, float r,
+                        float cd = constants::DEFAULT_DRAG_COEFFICIENT);
+    void reserve(std::size_t capacity);
+    void clear();
+    std::size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    // Lightweight handle to body i (valid until bodies are added or removed).
+    Object operator[](std::size_t i) { return Object(*this, i); }
+
+};
+
+
+#endif //GRAVITY_SIMULATOR_PARTICLESYSTEM_H
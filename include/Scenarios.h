@@ -0,0 +1,22 @@
+#ifndef GRAVITY_SIMULATOR_SCENARIOS_H
+#define GRAVITY_SIMULATOR_SCENARIOS_H
+
+#include <cstddef>
+
+class ParticleSystem;
+
+// Initial conditions shared by the viewer and the headless runner.
+namespace scenarios {
+
+    // The original two-body setup: an Earth-mass body in the middle of the
+    // screen and a Moon-mass body to its right, moving downwards.
+    void addEarthMoon(ParticleSystem& particles);
+
+    // A central Earth-mass body surrounded by `count` light bodies on roughly
+    // circular orbits, for large-N runs. Deterministic for a given seed.
+    void addOrbitingDisk(ParticleSystem& particles, std::size_t count, unsigned seed = 1);
+
+}
+
+
+#endif //GRAVITY_SIMULATOR_SCENARIOS_H
@@ -0,0 +1,17 @@
+#ifndef GRAVITY_SIMULATOR_SHADERPROGRAM_H
+#define GRAVITY_SIMULATOR_SHADERPROGRAM_H
+
+#include "ViewTransform.h"
+
+// Small GL helpers shared by the viewer's renderers (viewer target only).
+
+// Compiles and links a vertex + fragment shader pair. Returns 0 (after
+// printing the log, tagged with owner) if either step fails.
+unsigned int buildShaderProgram(const char* vertexSource, const char* fragmentSource, const char* owner);
+
+// Uploads view as the "vec4 transform" uniform the viewer's shaders use:
+// clip = world * transform.xy + transform.zw.
+void setViewUniform(int location, const ViewTransform& view);
+
+
+#endif //GRAVITY_SIMULATOR_SHADERPROGRAM_H
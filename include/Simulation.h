@@ -0,0 +1,83 @@
+#ifndef GRAVITY_SIMULATOR_SIMULATION_H
+#define GRAVITY_SIMULATOR_SIMULATION_H
+
+#include <memory>
+#include "AlignedAllocator.h"
+#include "AtmosphericDrag.h"
+#include "GravitySolver.h"
+#include "Integrator.h"
+#include "ParticleSystem.h"
+
+class ThreadPool;
+
+// Owns the bodies and advances them in strictly separated phases:
+//   force phase  - reads positions only, writes the scratch acceleration buffer
+//   kick / drift - read the scratch buffer / velocities, write velocities / positions
+// No body ever sees another body's half-updated state, and every phase can be
+// split across threads without any synchronisation inside it. The Integrator
+// decides how the phases are sequenced within a step.
+class Simulation {
+public:
+    // A null integrator selects velocity Verlet.
+    explicit Simulation(std::unique_ptr<GravitySolver> gravity,
+                        ThreadPool* pool = nullptr,
+                        std::unique_ptr<Integrator> integrator = nullptr);
+
+    // Mutable access counts as an edit: it drops the cached accelerations, so
+    // the next step re-evaluates the forces. Use the const overload to only
+    // read. Edits made later through a reference kept across steps are not
+    // seen; call invalidateAccelerations() after those.
+    ParticleSystem& particles() { accValid = false; return bodies; }
+    const ParticleSystem& particles() const { return bodies; }
+
+    // Advance every body by dt (in simulation ticks; one tick per frame is the
+    // original loop's rate) using the current integrator.
+    void step(float dt);
+
+    void setIntegrator(std::unique_ptr<Integrator> integrator);
+
+    // Optional drag force, added to gravity in the force phase (null = off).
+    void setDrag(std::unique_ptr<AtmosphericDrag> drag);
+    // (mutable access drops the cached accelerations, like particles())
+    AtmosphericDrag* drag() { accValid = false; return dragForce.get(); }
+    const AtmosphericDrag* drag() const { return dragForce.get(); }
+
+    // Building blocks for the integrators:
+    // fill accelerationX/Y from the current positions (gravity, plus drag when
+    // enabled, which also reads the velocities)
+    void computeAccelerations();
+    // v += a*h
+    void kick(float h);
+    // x += v*h (invalidates the accelerations)
+    void drift(float h);
+    // true when the acceleration buffer matches the current positions
+    bool accelerationsValid() const { return accValid && ax.size() == bodies.size(); }
+    // forget the cached accelerations (after changing bodies, solver or drag
+    // settings behind the simulation's back)
+    void invalidateAccelerations() { accValid = false; }
+
+    const AlignedVector<float>& accelerationX() const { return ax; }
+    const AlignedVector<float>& accelerationY() const { return ay; }
+
+    double time() const { return simTime; }
+    // mutable access (e.g. to change theta) drops the cached accelerations
+    GravitySolver& gravitySolver() { accValid = false; return *gravity; }
+    const GravitySolver& gravitySolver() const { return *gravity; }
+
+private:
+    ParticleSystem bodies;
+    std::unique_ptr<GravitySolver> gravity;
+    ThreadPool* pool;
+    std::unique_ptr<Integrator> integrator;
+    std::unique_ptr<AtmosphericDrag> dragForce;
+
+    // scratch buffers written by the force phase
+    AlignedVector<float> ax;
+    AlignedVector<float> ay;
+    bool accValid = false;
+
+    double simTime = 0.0;
+};
+
+
+#endif //GRAVITY_SIMULATOR_SIMULATION_H
@@ -0,0 +1,77 @@
+#ifndef GRAVITY_SIMULATOR_SIMULATIONRUNNER_H
+#define GRAVITY_SIMULATOR_SIMULATIONRUNNER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "TripleBuffer.h"
+
+class ParticleSystem;
+class Simulation;
+
+// What a renderer needs from one simulation step: positions before and after
+// it (so the display can be interpolated in between), radii and timing.
+struct SimulationSnapshot
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<float> previousX, previousY;   // positions at the start of the step
+    std::vector<float> x, y;                   // positions at the end of the step
+    std::vector<float> radius;
+
+    double time = 0.0;            // simulation time at the end of the step
+    std::uint64_t steps = 0;      // steps taken so far
+    Clock::time_point published;  // wall-clock time the step finished
+    double stepInterval = 0.0;    // wall-clock seconds between steps (0 = unpaced)
+
+    std::size_t size() const { return x.size(); }
+
+    // How far (0..1) the display should be from previous* towards the end
+    // positions at wall-clock time now. Showing the blend lags the physics by
+    // at most one step but moves smoothly whatever the two rates are.
+    float blendFactor(Clock::time_point now) const;
+};
+
+
+// Runs a Simulation on its own thread at a fixed rate of steps per second,
+// independent of the display, and publishes a SimulationSnapshot after every
+// step through a TripleBuffer. The render thread picks up the newest snapshot
+// with latest() without ever locking or waiting for the physics.
+//
+// While running, the simulation (and the thread pool it uses) belongs to the
+// runner thread; touch it again only after stop().
+class SimulationRunner {
+public:
+    // stepsPerSecond <= 0 steps as fast as possible
+    SimulationRunner(Simulation& simulation, double stepsPerSecond, float dt = 1.0f);
+    ~SimulationRunner();
+
+    SimulationRunner(const SimulationRunner&) = delete;
+    SimulationRunner& operator=(const SimulationRunner&) = delete;
+
+    void start();
+    void stop();
+    bool running() const { return worker.joinable(); }
+
+    // Render thread only: the newest published snapshot (the same one as last
+    // time if no step finished since).
+    const SimulationSnapshot& latest();
+
+private:
+    void run();
+    void captureStart(SimulationSnapshot& snapshot) const;
+    void captureEnd(SimulationSnapshot& snapshot, std::uint64_t steps) const;
+
+    Simulation& simulation;
+    double stepsPerSecond;
+    float dt;
+
+    TripleBuffer<SimulationSnapshot> snapshots;
+    std::thread worker;
+    std::atomic<bool> stopRequested{false};
+};
+
+
+#endif //GRAVITY_SIMULATOR_SIMULATIONRUNNER_H
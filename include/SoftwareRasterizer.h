@@ -0,0 +1,78 @@
+#ifndef GRAVITY_SIMULATOR_SOFTWARERASTERIZER_H
+#define GRAVITY_SIMULATOR_SOFTWARERASTERIZER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "DrawList.h"
+
+class ThreadPool;
+
+// RGBA8 image (pixels packed like packColor), row 0 at the bottom like the
+// viewer's window.
+struct Framebuffer
+{
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint32_t> pixels;
+
+    std::uint32_t& at(int x, int y) { return pixels[static_cast<std::size_t>(y) * width + x]; }
+    std::uint32_t at(int x, int y) const { return pixels[static_cast<std::size_t>(y) * width + x]; }
+};
+
+// Binary PPM (P6, RGB, alpha dropped), top row first.
+void writePpm(std::ostream& out, const Framebuffer& frame);
+// Bare RGBA bytes, top row first: one frame after the other makes a raw video
+// stream (e.g. ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i -).
+void writeRawRgba(std::ostream& out, const Framebuffer& frame);
+
+
+// Draws a DrawList into a Framebuffer on the CPU, for machines without a GPU
+// or a display. It follows the viewer's rules so both show the same picture:
+// the same view transform, lines first, then circles, then one-pixel points,
+// every primitive opaque in that order. Circles are filled exactly (pixel
+// centres inside the radius), which matches the viewer's tessellated circles
+// to within the LOD tolerance.
+//
+// The frame is split into square tiles. Primitives are binned to the tiles
+// their bounds touch, then the tiles are filled in parallel; each tile is
+// written by one thread only and keeps the draw order, so the result does not
+// depend on the thread count.
+class SoftwareRasterizer {
+public:
+    static constexpr int TILE_SIZE = 64;
+
+    SoftwareRasterizer(int width, int height, ThreadPool* pool = nullptr);
+
+    void setBackground(std::uint32_t color) { background = color; }
+
+    // clears to the background and draws the whole list
+    void draw(const DrawList& list);
+
+    const Framebuffer& framebuffer() const { return frame; }
+
+private:
+    struct Disc { float x, y, radius; std::uint32_t color; };       // screen pixels, radius 0 = point
+    struct Segment { float x0, y0, x1, y1; std::uint32_t color; };  // screen pixels
+
+    void bin(const DrawList& list);
+    void binBounds(float minX, float minY, float maxX, float maxY, std::uint32_t item);
+    void drawTile(int tile);
+    void drawDisc(const Disc& d, int x0, int y0, int x1, int y1);
+    void drawSegment(const Segment& s, int x0, int y0, int x1, int y1);
+
+    Framebuffer frame;
+    ThreadPool* pool;
+    std::uint32_t background = packColor(0, 0, 0);
+    int tilesX;
+    int tilesY;
+
+    // this frame's primitives in screen space; an item id below
+    // segments.size() is a segment, the rest are discs (in draw order)
+    std::vector<Segment> segments;
+    std::vector<Disc> discs;
+    std::vector<std::vector<std::uint32_t>> tileItems;
+};
+
+
+#endif //GRAVITY_SIMULATOR_SOFTWARERASTERIZER_H
@@ -0,0 +1,51 @@
+#ifndef GRAVITY_SIMULATOR_SPACEWEATHER_H
+#define GRAVITY_SIMULATOR_SPACEWEATHER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One row of solar / geomagnetic indices, valid from `time` until the next row.
+struct SpaceWeatherRecord
+{
+    double time = 0.0;     // s, on the simulation clock
+    double f107 = 150.0;   // daily 10.7 cm solar flux, sfu
+    double f107a = 150.0;  // 81-day centred average of F10.7, sfu
+    double ap = 15.0;      // daily planetary geomagnetic index
+};
+
+// Time series of space-weather indices, e.g. loaded from a local CSV:
+//   time,f107,f107a,ap
+//   0,150.2,148.9,12
+//   86400,155.0,149.1,27
+// Rows must be sorted by time. Before the first row the first one applies,
+// after the last row the last one.
+class SpaceWeatherTable {
+public:
+    // a single record of moderate activity (F10.7 = 150, Ap = 15)
+    SpaceWeatherTable();
+    explicit SpaceWeatherTable(std::vector<SpaceWeatherRecord> records);
+
+    // Reads the CSV above: an optional header as the first line that is not a
+    // comment, then exactly four numbers per line; blank lines and lines
+    // starting with '#' are skipped. Throws std::runtime_error if the file
+    // cannot be read, a line is malformed or there are no records.
+    static SpaceWeatherTable loadCsv(const std::string& path);
+
+    // Index of the record in effect at `time`. `hint` is where to start looking:
+    // moving forward from the previous answer is O(1) per step.
+    std::size_t indexAt(double time, std::size_t hint = 0) const;
+    const SpaceWeatherRecord& at(double time) const { return records[indexAt(time)]; }
+
+    const SpaceWeatherRecord& operator[](std::size_t i) const { return records[i]; }
+    std::size_t size() const { return records.size(); }
+
+private:
+    std::vector<SpaceWeatherRecord> records;
+};
+
+// Planetary Kp from the ap index, interpolating the standard conversion table.
+double kpFromAp(double ap);
+
+
+#endif //GRAVITY_SIMULATOR_SPACEWEATHER_H
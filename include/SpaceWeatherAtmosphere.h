@@ -0,0 +1,76 @@
+#ifndef GRAVITY_SIMULATOR_SPACEWEATHERATMOSPHERE_H
+#define GRAVITY_SIMULATOR_SPACEWEATHERATMOSPHERE_H
+
+#include "SpaceWeather.h"
+#include "TimeVaryingAtmosphere.h"
+#include "US76_atmosphere.h"
+
+// US76 profile made to respond to solar and geomagnetic activity.
+//
+// The exospheric temperature follows Jacchia (1970):
+//   Tc   = 379 + 3.24*F10.7a + 1.3*(F10.7 - F10.7a)
+//   Tinf = Tc + 28*Kp + 0.03*exp(Kp)            (Kp from Ap)
+// Above 120 km the thermosphere scale heights grow with Tinf: the US76
+// profile (whose Tinf is 1000 K) is stretched about 120 km by Tinf/1000, i.e.
+// a body at h sees the US76 density of 120 km + (h - 120 km) * 1000/Tinf,
+// and the temperature rise above 120 km is scaled to end at Tinf. Below
+// 120 km the plain US76 / ISA values apply. Latitude, longitude and local
+// time are not modelled.
+//
+// advanceTo() looks up the indices for the new time (moving a cursor through
+// the table) and precomputes the stretch factors (bumping generation() when
+// they change); every query after that is a US76 table lookup plus a few
+// multiplies.
+class SpaceWeatherAtmosphere: public TimeVaryingAtmosphere {
+public:
+    explicit SpaceWeatherAtmosphere(SpaceWeatherTable weather = SpaceWeatherTable());
+    virtual ~SpaceWeatherAtmosphere() = default;
+
+    double getTemperature(double altitude) const override;
+    double getPressure(double altitude) const override;
+    double getDensity(double altitude) const override;
+
+    void getProperties(double altitudeMeters,
+                       double &temperature,
+                       double &pressure,
+                       double &density) const override;
+
+    AtmosphereState getState(double altitudeMeters) const override;
+    AtmosphereState getState(double altitudeMeters,
+                             double timeSeconds,
+                             double latitude = 0.0,
+                             double longitude = 0.0) const override;
+
+    void getPropertiesBatch(const double* altitudes,
+                            std::size_t count,
+                            double* temperature,
+                            double* pressure,
+                            double* density) const override;
+
+    void advanceTo(double timeSeconds) override;
+
+    // Tinf for the current time, K
+    double exosphericTemperature() const { return current.exosphericTemperature; }
+    const SpaceWeatherTable& spaceWeather() const { return weather; }
+
+private:
+    // everything a query needs for one set of indices
+    struct Coefficients
+    {
+        double exosphericTemperature;   // K
+        double stretch;                 // 1000 K / Tinf
+        double temperatureScale;        // (Tinf - T120) / (1000 K - T120)
+    };
+
+    static Coefficients coefficientsFor(const SpaceWeatherRecord& indices);
+    void evaluate(double altitudeMeters, const Coefficients& c,
+                  double &temperature, double &pressure, double &density) const;
+
+    US76_atmosphere reference;
+    SpaceWeatherTable weather;
+    std::size_t cursor = 0;
+    Coefficients current{};
+};
+
+
+#endif //GRAVITY_SIMULATOR_SPACEWEATHERATMOSPHERE_H
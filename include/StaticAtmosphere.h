@@ -0,0 +1,115 @@
+#ifndef GRAVITY_SIMULATOR_STATICATMOSPHERE_H
+#define GRAVITY_SIMULATOR_STATICATMOSPHERE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "AtmosphereState.h"
+#include "ISA_tables.h"
+#include "atmosphere.h"
+
+// Compile-time counterpart of the Atmosphere interface, for hot loops that
+// know their model when they are compiled (e.g. a drag kernel templated on
+// the atmosphere). Model is any type with
+//   static void evaluate(double altitude, double& T, double& P, double& rho);
+// and every call below is a direct, inlinable call into it: no vtable, no
+// unique_ptr, layer constants folded into the caller.
+//
+// Runtime selection still goes through AtmosphereFactory / Atmosphere.
+template <typename Model>
+class StaticAtmosphere {
+    static_assert(std::is_invocable_r_v<void, decltype(&Model::evaluate), double, double&, double&, double&>,
+                  "Model needs static void evaluate(double, double&, double&, double&)");
+
+public:
+    static double getTemperature(double altitude)
+    {
+        double T, P, rho;
+        Model::evaluate(altitude, T, P, rho);
+        return T;
+    }
+
+    static double getPressure(double altitude)
+    {
+        double T, P, rho;
+        Model::evaluate(altitude, T, P, rho);
+        return P;
+    }
+
+    static double getDensity(double altitude)
+    {
+        double T, P, rho;
+        Model::evaluate(altitude, T, P, rho);
+        return rho;
+    }
+
+    static void getProperties(double altitudeMeters, double& temperature, double& pressure, double& density)
+    {
+        Model::evaluate(altitudeMeters, temperature, pressure, density);
+    }
+
+    static AtmosphereState getState(double altitudeMeters)
+    {
+        double T, P, rho;
+        Model::evaluate(altitudeMeters, T, P, rho);
+        return air::makeState(T, P, rho);
+    }
+
+    static void getPropertiesBatch(const double* altitudes, std::size_t count,
+                                   double* temperature, double* pressure, double* density)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            Model::evaluate(altitudes[i], temperature[i], pressure[i], density[i]);
+    }
+};
+
+// A static model behind the runtime Atmosphere interface, for code that needs
+// an Atmosphere next to a kernel calling the model directly (StaticDrag hands
+// it to Simulation for advanceTo / generation and the vacuum diagnostics).
+// Only getPropertiesBatch counts vacuum queries, as in the runtime models.
+// The class is final, so calls through a StaticModelAtmosphere<Model>& are
+// direct and inline Model::evaluate.
+template <typename Model>
+class StaticModelAtmosphere final: public Atmosphere {
+public:
+    double getTemperature(double altitude) const override { return StaticAtmosphere<Model>::getTemperature(altitude); }
+    double getPressure(double altitude) const override { return StaticAtmosphere<Model>::getPressure(altitude); }
+    double getDensity(double altitude) const override { return StaticAtmosphere<Model>::getDensity(altitude); }
+
+    void getProperties(double altitudeMeters, double &temperature, double &pressure, double &density) const override
+    {
+        Model::evaluate(altitudeMeters, temperature, pressure, density);
+    }
+
+    AtmosphereState getState(double altitudeMeters) const override
+    {
+        return StaticAtmosphere<Model>::getState(altitudeMeters);
+    }
+
+    void getPropertiesBatch(const double* altitudes, std::size_t count,
+                            double* temperature, double* pressure, double* density) const override
+    {
+        std::uint64_t spaceCount = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Model::evaluate(altitudes[i], temperature[i], pressure[i], density[i]);
+            spaceCount += (density[i] < VACUUM_DENSITY);
+        }
+        countVacuumQueries(spaceCount);
+    }
+};
+
+// The ISA as a static model (same tables and code as ISA_atmosphere, minus the
+// "in space" warning, which is a diagnostic of the runtime class).
+struct IsaModel
+{
+    static void evaluate(double altitude, double& T, double& P, double& rho)
+    {
+        isa::evaluate(altitude, T, P, rho);
+    }
+};
+
+using StaticISA = StaticAtmosphere<IsaModel>;
+
+
+#endif //GRAVITY_SIMULATOR_STATICATMOSPHERE_H
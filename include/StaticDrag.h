@@ -0,0 +1,46 @@
+#ifndef GRAVITY_SIMULATOR_STATICDRAG_H
+#define GRAVITY_SIMULATOR_STATICDRAG_H
+
+#include <cstddef>
+#include <memory>
+#include "AtmosphericDrag.h"
+#include "StaticAtmosphere.h"
+
+// AtmosphericDrag with the atmosphere fixed at compile time: the drag loop
+// reaches Model::evaluate through direct calls only (no virtual call per
+// chunk), so the model and its layer constants are inlined into the loop. Simulation holds it like any
+// other AtmosphericDrag:
+//   simulation.setDrag(std::make_unique<StaticDrag<IsaModel>>(0));
+// atmosphere() is the same model behind the runtime interface
+// (StaticModelAtmosphere), so advanceTo(), generation() and
+// takeVacuumQueryCount() work as with the runtime drag. Static models do not
+// vary in time.
+template <typename Model>
+class StaticDrag: public AtmosphericDrag {
+public:
+    explicit StaticDrag(std::size_t centralBody = 0)
+        : AtmosphericDrag(std::make_unique<StaticModelAtmosphere<Model>>(), centralBody),
+          air(static_cast<const StaticModelAtmosphere<Model>&>(atmosphere()))
+    {
+    }
+
+    void addAccelerations(const ParticleSystem& bodies, float* ax, float* ay, ThreadPool* pool) const override
+    {
+        // StaticModelAtmosphere is final: this batch call is direct
+        const StaticModelAtmosphere<Model>& model = air;
+        addAccelerationsWith(bodies, ax, ay, pool,
+                             [&model](const double* altitudes, std::size_t count, double* T, double* P, double* rho)
+                             {
+                                 model.getPropertiesBatch(altitudes, count, T, P, rho);
+                             });
+    }
+
+private:
+    const StaticModelAtmosphere<Model>& air;
+};
+
+// drag in the ISA through the compile-time path
+using StaticIsaDrag = StaticDrag<IsaModel>;
+
+
+#endif //GRAVITY_SIMULATOR_STATICDRAG_H
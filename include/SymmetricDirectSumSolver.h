@@ -0,0 +1,30 @@
+#ifndef GRAVITY_SIMULATOR_SYMMETRICDIRECTSUMSOLVER_H
+#define GRAVITY_SIMULATOR_SYMMETRICDIRECTSUMSOLVER_H
+
+#include <cstddef>
+#include "GravitySolver.h"
+
+// Exact direct sum that uses Newton's third law: every unordered pair (i, j)
+// is evaluated once and the equal and opposite accelerations are applied to
+// both bodies, halving the sqrt/divide work of DirectSumSolver.
+//
+// Bodies are grouped into tiles of TILE_SIZE. Tile pairs are processed in
+// "colours" (rounds of a round-robin schedule) in which no two tiles touch the
+// same body, so the tiles of one colour run in parallel without locks or
+// per-thread copies. Since the schedule does not depend on the pool, the
+// summation order per body - and hence the result - is the same for any
+// number of threads.
+class SymmetricDirectSumSolver: public GravitySolver {
+public:
+    static constexpr std::size_t TILE_SIZE = 256;
+
+    SymmetricDirectSumSolver() = default;
+    virtual ~SymmetricDirectSumSolver() = default;
+
+    void computeAccelerations(const ParticleSystem& particles,
+                              float* ax,
+                              float* ay) override;
+};
+
+
+#endif //GRAVITY_SIMULATOR_SYMMETRICDIRECTSUMSOLVER_H
@@ -0,0 +1,114 @@
+#ifndef GRAVITY_SIMULATOR_TABULATEDATMOSPHERE_H
+#define GRAVITY_SIMULATOR_TABULATEDATMOSPHERE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "atmosphere.h"
+
+enum class TableSpacing {
+    Uniform,       // equal altitude steps
+    Logarithmic,   // steps growing with altitude (dense near the ground)
+};
+
+struct TableOptions
+{
+    double minAltitude = 0.0;        // m
+    double maxAltitude = 1.0e6;      // m, queries outside [min, max] go to the source model
+    std::size_t samples = 4001;      // nodes in the table
+    TableSpacing spacing = TableSpacing::Uniform;
+    // If > 0, the table is refined to 2n-1 samples (halving the spacing, up to
+    // maxSamples) until the estimated max relative error of T, P and rho is
+    // below this value.
+    double targetRelativeError = 0.0;
+    std::size_t maxSamples = 1u << 20;
+};
+
+// Lookup-table atmosphere: samples any other static Atmosphere once on
+// construction and afterwards answers queries with a piecewise cubic (one cubic per table
+// interval, through four samples of the source inside that interval). A query
+// is an index computation plus three Horner polynomials: no pow/exp on the hot
+// path (log spacing costs one std::log1p for the index).
+//
+// Because no interval looks at its neighbours' samples, a kink or jump of the
+// source that falls on a node (all ISA layer boundaries are whole km, so they
+// are nodes of any uniform table from 0 m with a step dividing 1 km) costs no
+// accuracy. Log spacing suits smooth sources; off-node kinks show up in the
+// estimated error.
+//
+// The table is a snapshot, so time-varying sources (TimeVaryingAtmosphere)
+// are rejected with an exception instead of being frozen at their current
+// time; advanceTo() on the table does nothing.
+//
+// After building the table it is compared with the source model at 18 points
+// of every interval (two of them just inside the ends), followed by a few
+// rounds of denser checks around each interval's worst point. The worst
+// relative error found for each quantity is available through the
+// maxRelativeError*() accessors. It is an estimate from that search, not a
+// proven bound, although it tracks the true maximum closely even next to a
+// jump of the source inside an interval.
+class TabulatedAtmosphere: public Atmosphere {
+public:
+    explicit TabulatedAtmosphere(std::unique_ptr<Atmosphere> source,
+                                 const TableOptions& options = TableOptions());
+    virtual ~TabulatedAtmosphere() = default;
+
+    double getTemperature(double altitude) const override;
+    double getPressure(double altitude) const override;
+    double getDensity(double altitude) const override;
+
+    void getProperties(double altitudeMeters,
+                       double &temperature,
+                       double &pressure,
+                       double &density) const override;
+
+    AtmosphereState getState(double altitudeMeters) const override;
+
+    void getPropertiesBatch(const double* altitudes,
+                            std::size_t count,
+                            double* temperature,
+                            double* pressure,
+                            double* density) const override;
+
+    // estimated worst relative error of the table against the source
+    double maxRelativeErrorTemperature() const { return errorT; }
+    double maxRelativeErrorPressure() const { return errorP; }
+    double maxRelativeErrorDensity() const { return errorRho; }
+    // worst of the three
+    double maxRelativeError() const;
+
+    std::size_t sampleCount() const { return segments.size() + 1; }
+    const Atmosphere& sourceModel() const { return *source; }
+
+private:
+    // cubic in the local coordinate t in [0, 1): c0 + t*(c1 + t*(c2 + t*c3)),
+    // one per quantity, kept together so a lookup touches a single record
+    struct Segment
+    {
+        double T[4];
+        double P[4];
+        double rho[4];
+    };
+
+    void build(std::size_t samples);
+    void measureError();
+    double coordinate(double altitude) const;   // fractional node index, 0 at minAltitude
+    double altitudeAt(double coord) const;
+    void interpolate(double altitude, double& T, double& P, double& rho) const;
+
+    std::unique_ptr<Atmosphere> source;
+    TableOptions options;
+    std::vector<Segment> segments;
+
+    // altitude <-> table coordinate
+    double step = 1.0;          // uniform: metres per node; log: ln-units per node
+    double invStep = 1.0;
+    double logScale = 1000.0;   // log spacing: u = ln(1 + (h - hMin)/logScale)
+
+    double errorT = 0.0;
+    double errorP = 0.0;
+    double errorRho = 0.0;
+};
+
+
+#endif //GRAVITY_SIMULATOR_TABULATEDATMOSPHERE_H
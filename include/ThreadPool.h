@@ -0,0 +1,76 @@
+#ifndef GRAVITY_SIMULATOR_THREADPOOL_H
+#define GRAVITY_SIMULATOR_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Persistent pool of worker threads for the per-step loops.
+// The threads are created once and sleep between jobs, so a frame never pays
+// for thread creation. parallelFor() splits [0, count) into fixed-size chunks;
+// each index is handled by exactly one call, so as long as the work for an
+// index only depends on frozen input, results are bit-identical no matter how
+// many threads run or which thread grabs which chunk.
+class ThreadPool {
+public:
+    // threadCount includes the calling thread, which also works on each job.
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Calls fn(begin, end) over disjoint ranges covering [0, count) and returns
+    // once all of them are done. fn must not throw.
+    template <typename Fn>
+    void parallelFor(std::size_t count, Fn&& fn)
+    {
+        using FnType = typename std::remove_reference<Fn>::type;
+        run(count,
+            [](void* ctx, std::size_t begin, std::size_t end) { (*static_cast<FnType*>(ctx))(begin, end); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+private:
+    using RangeFn = void (*)(void*, std::size_t, std::size_t);
+
+    void run(std::size_t count, RangeFn fn, void* ctx);
+    void workerLoop();
+    void workOnChunks();
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobDone;
+    unsigned long long generation = 0;   // bumped for every new job
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+
+    // current job (only valid while a parallelFor is running)
+    RangeFn jobFn = nullptr;
+    void* jobCtx = nullptr;
+    std::size_t jobCount = 0;
+    std::size_t jobChunk = 1;
+    std::atomic<std::size_t> nextChunk{0};
+};
+
+// Runs fn(0, count) directly when no pool is given, so callers can stay
+// agnostic of whether they were handed one.
+template <typename Fn>
+void parallelFor(ThreadPool* pool, std::size_t count, Fn&& fn)
+{
+    if (pool && count > 1)
+        pool->parallelFor(count, fn);
+    else if (count > 0)
+        fn(std::size_t(0), count);
+}
+
+
+#endif //GRAVITY_SIMULATOR_THREADPOOL_H
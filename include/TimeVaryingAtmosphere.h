@@ -0,0 +1,33 @@
+#ifndef GRAVITY_SIMULATOR_TIMEVARYINGATMOSPHERE_H
+#define GRAVITY_SIMULATOR_TIMEVARYINGATMOSPHERE_H
+
+#include "atmosphere.h"
+
+// Atmosphere whose state also depends on time (and optionally position on the
+// globe), e.g. driven by solar flux and geomagnetic activity.
+//
+// Two ways to query it:
+//  - the plain Atmosphere calls (altitude only) answer for the time given to
+//    the last advanceTo(), from coefficients precomputed there; this is the
+//    hot path used by the drag force
+//  - getState(altitude, time, lat, lon) answers for any time without touching
+//    the precomputed state (slower, for analysis / one-off queries)
+class TimeVaryingAtmosphere: public Atmosphere {
+public:
+    using Atmosphere::getState;
+
+    // latitude / longitude in radians; models without a geographic term ignore them
+    virtual AtmosphereState getState(double altitudeMeters,
+                                     double timeSeconds,
+                                     double latitude = 0.0,
+                                     double longitude = 0.0) const = 0;
+
+    // time of the last advanceTo()
+    double currentTime() const { return now; }
+
+protected:
+    double now = 0.0;
+};
+
+
+#endif //GRAVITY_SIMULATOR_TIMEVARYINGATMOSPHERE_H
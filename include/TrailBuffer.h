@@ -0,0 +1,66 @@
+#ifndef GRAVITY_SIMULATOR_TRAILBUFFER_H
+#define GRAVITY_SIMULATOR_TRAILBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DrawList.h"
+#include "Vec2.h"
+
+class ThreadPool;
+
+// Recent positions of every body, for drawing trajectories.
+//
+// All trails live in one arena of bodies x capacity points; body i owns the
+// fixed slice [i * capacity, (i + 1) * capacity) and uses it as a ring buffer
+// (head + count), so memory is fixed at resize() time - 8 bytes per point
+// plus 12 per body, e.g. ~26 MB for 100k bodies with 32 points each - and
+// recording never allocates.
+//
+// The newest point of each trail is live: every record() moves it to the
+// body's current position, so the trail always ends at the body. It is kept
+// (and a new live point started) only when either
+//   - stride samples have passed since the last kept point, or
+//   - the body has left the straight continuation of its last kept segment
+//     by more than bendTolerance (world units),
+// so straight stretches are stored sparsely and curves finely.
+class TrailBuffer {
+public:
+    explicit TrailBuffer(std::size_t capacity = 32, unsigned stride = 8, float bendTolerance = 0.5f);
+
+    // drops every trail and makes room for bodyCount bodies
+    void resize(std::size_t bodyCount);
+    void clear();
+
+    // One sample of every body's position (x[i], y[i]). Resizes (clearing the
+    // trails) if the body count changed.
+    void record(const float* x, const float* y, std::size_t bodyCount, ThreadPool* pool = nullptr);
+
+    // one line strip per trail, oldest point first
+    void addTo(DrawList& list, std::uint32_t color) const;
+
+    std::size_t bodyCount() const { return head.size(); }
+    std::size_t capacity() const { return cap; }
+    std::size_t length(std::size_t body) const { return count[body]; }
+    // point k (0 = oldest) of body's trail
+    Vec2 point(std::size_t body, std::size_t k) const
+    {
+        return points[body * cap + (head[body] + cap - count[body] + 1 + k) % cap];
+    }
+    std::size_t memoryBytes() const;
+
+private:
+    void recordBody(std::size_t body, Vec2 p);
+
+    std::size_t cap;
+    unsigned stride;
+    float bendTolerance;
+
+    std::vector<Vec2> points;            // the arena
+    std::vector<std::uint32_t> head;     // slot of the live point
+    std::vector<std::uint32_t> count;    // points in use, live one included
+    std::vector<std::uint32_t> age;      // samples since the last kept point
+};
+
+
+#endif //GRAVITY_SIMULATOR_TRAILBUFFER_H
@@ -0,0 +1,51 @@
+#ifndef GRAVITY_SIMULATOR_TRIPLEBUFFER_H
+#define GRAVITY_SIMULATOR_TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Single-producer / single-consumer hand-over of whole values without locks.
+// The writer fills writeBuffer() and publish()es it; the reader calls update()
+// to pick up the newest published value and then reads readBuffer() for as
+// long as it likes. Three slots mean neither side ever waits for the other:
+// the writer always has a free slot, and a slow reader simply skips the
+// values published in between.
+//
+// Slots are reused, so a value must be rewritten completely before it is
+// published (containers keep their capacity, so this does not allocate).
+template <typename T>
+class TripleBuffer {
+public:
+    // writer side
+    T& writeBuffer() { return slots[writeIndex]; }
+    void publish()
+    {
+        // swap our slot with the middle one; release makes its contents
+        // visible to the reader's acquire below
+        const unsigned previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // reader side: true if a newer value was picked up
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        const unsigned previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr unsigned INDEX_MASK = 3;
+    static constexpr unsigned FRESH = 4;   // middle slot holds an unread value
+
+    T slots[3];
+    // each side's index on its own cache line, away from the shared one
+    alignas(64) unsigned writeIndex = 0;
+    alignas(64) std::atomic<unsigned> middle{1};
+    alignas(64) unsigned readIndex = 2;
+};
+
+
+#endif //GRAVITY_SIMULATOR_TRIPLEBUFFER_H
@@ -0,0 +1,67 @@
+#ifndef GRAVITY_SIMULATOR_US76_ATMOSPHERE_H
+#define GRAVITY_SIMULATOR_US76_ATMOSPHERE_H
+
+#include <vector>
+#include "atmosphere.h"
+
+// US Standard Atmosphere 1976 including the thermosphere: the ISA layers
+// below 86 km, then a table of US76 values from 86 to 1000 km with
+// temperature interpolated linearly and pressure / density exponentially
+// (a constant scale height per table segment). Above 1000 km the last
+// segment is extrapolated.
+//
+// Unlike ISA_atmosphere's isothermal extension, the density follows the real
+// thermosphere (about 6e-11 kg/m^3 at 250 km, 3.6e-15 at 1000 km), which
+// is what orbital decay depends on. Segment lookup is a km bucket table,
+// so a query costs the same as an ISA one (two exp instead of one pow).
+// getState() derives speed of sound and viscosity with the dry-air constants,
+// which are only approximate above ~90 km where the mean molar mass drops.
+class US76_atmosphere: public Atmosphere {
+public:
+    US76_atmosphere();
+    virtual ~US76_atmosphere() = default;
+
+    double getTemperature(double altitude) const override;
+    double getPressure(double altitude) const override;
+    double getDensity(double altitude) const override;
+
+    void getProperties(double altitudeMeters,
+                       double &temperature,
+                       double &pressure,
+                       double &density) const override;
+
+    AtmosphereState getState(double altitudeMeters) const override;
+
+    void getPropertiesBatch(const double* altitudes,
+                            std::size_t count,
+                            double* temperature,
+                            double* pressure,
+                            double* density) const override;
+
+    // The model without the vacuum-query diagnostics, for models built on top
+    // of this one (SpaceWeatherAtmosphere) that count their own queries.
+    void evaluate(double altitudeMeters, double &temperature, double &pressure, double &density) const;
+    void evaluateBatch(const double* altitudes,
+                       std::size_t count,
+                       double* temperature,
+                       double* pressure,
+                       double* density) const;
+
+private:
+    // one table interval, with the logarithmic slopes precomputed
+    struct Segment
+    {
+        double hBase;        // m
+        double tBase;        // K
+        double lapseRate;    // K/m
+        double pBase;        // Pa
+        double pSlope;       // d ln(P) / dh, 1/m
+        double rhoBase;      // kg/m^3
+        double rhoSlope;     // d ln(rho) / dh, 1/m
+    };
+
+    std::vector<Segment> segments;
+};
+
+
+#endif //GRAVITY_SIMULATOR_US76_ATMOSPHERE_H
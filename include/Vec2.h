@@ -0,0 +1,35 @@
+#ifndef GRAVITY_SIMULATOR_VEC2_H
+#define GRAVITY_SIMULATOR_VEC2_H
+
+#include <cmath>
+
+// Small 2D vector passed by value (lives in registers / on the stack), used
+// wherever the physics code needs a position, velocity or acceleration as a
+// single quantity. Never allocates.
+struct Vec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr Vec2() = default;
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+    constexpr Vec2 operator+(Vec2 o) const { return {x + o.x, y + o.y}; }
+    constexpr Vec2 operator-(Vec2 o) const { return {x - o.x, y - o.y}; }
+    constexpr Vec2 operator-() const { return {-x, -y}; }
+    constexpr Vec2 operator*(float s) const { return {x * s, y * s}; }
+    constexpr Vec2 operator/(float s) const { return {x / s, y / s}; }
+
+    Vec2& operator+=(Vec2 o) { x += o.x; y += o.y; return *this; }
+    Vec2& operator-=(Vec2 o) { x -= o.x; y -= o.y; return *this; }
+    Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+
+    constexpr float dot(Vec2 o) const { return x * o.x + y * o.y; }
+    constexpr float lengthSquared() const { return dot(*this); }
+    float length() const { return std::sqrt(lengthSquared()); }
+};
+
+constexpr Vec2 operator*(float s, Vec2 v) { return v * s; }
+
+
+#endif //GRAVITY_SIMULATOR_VEC2_H
@@ -0,0 +1,33 @@
+#ifndef GRAVITY_SIMULATOR_VIEWTRANSFORM_H
+#define GRAVITY_SIMULATOR_VIEWTRANSFORM_H
+
+// Maps world coordinates (the simulation's pixel units) to screen pixels:
+// screen = world * scale + offset, over a viewport of width x height pixels
+// with the origin in the bottom-left corner. The default (scale 1, no offset)
+// is the fixed glOrtho(0, width, 0, height) mapping the viewer always used.
+struct ViewTransform
+{
+    float width = 0.0f;       // viewport size in pixels
+    float height = 0.0f;
+    float scale = 1.0f;       // screen pixels per world unit (zoom)
+    float offsetX = 0.0f;     // screen position of the world origin
+    float offsetY = 0.0f;
+
+    ViewTransform() = default;
+    ViewTransform(float width, float height, float scale = 1.0f, float offsetX = 0.0f, float offsetY = 0.0f)
+        : width(width), height(height), scale(scale), offsetX(offsetX), offsetY(offsetY) {}
+
+    float toScreenX(float x) const { return x * scale + offsetX; }
+    float toScreenY(float y) const { return y * scale + offsetY; }
+
+    // Zoom by factor keeping the world point under screen pixel (sx, sy) fixed.
+    void zoomAbout(float factor, float sx, float sy)
+    {
+        offsetX = sx - (sx - offsetX) * factor;
+        offsetY = sy - (sy - offsetY) * factor;
+        scale *= factor;
+    }
+};
+
+
+#endif //GRAVITY_SIMULATOR_VIEWTRANSFORM_H
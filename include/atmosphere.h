@@ -3,6 +3,11 @@
 #ifndef GRAVITY_SIMULATOR_ATMOSPHERE_H
 #define GRAVITY_SIMULATOR_ATMOSPHERE_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "AtmosphereState.h"
+
 
 class Atmosphere {
 public:
@@ -16,6 +21,72 @@ public:
                        double &temperature,
                        double &pressure,
                        double &density) const =0;
+
+    // T, P, rho plus speed of sound and viscosity from one model evaluation.
+    // Prefer this (or getProperties) over calling getTemperature and then
+    // getDensity, which runs the whole model twice.
+    virtual AtmosphereState getState(double altitudeMeters) const
+    {
+        double temperature, pressure, density;
+        getProperties(altitudeMeters, temperature, pressure, density);
+        return air::makeState(temperature, pressure, density);
+    }
+
+    // Batch version of getProperties: evaluates `count` altitudes in one call
+    // and writes element i of each output array. One virtual call per batch
+    // instead of one per body; models override it with a loop the compiler
+    // can vectorise. The default just loops over getProperties.
+    virtual void getPropertiesBatch(const double* altitudes,
+                                    std::size_t count,
+                                    double* temperature,
+                                    double* pressure,
+                                    double* density) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            getProperties(altitudes[i], temperature[i], pressure[i], density[i]);
+    }
+
+    // Called by the simulation once per step with the current simulation time
+    // (seconds) before any query of that step. Time-dependent models
+    // precompute their per-step coefficients here so the per-body queries stay
+    // cheap; static models ignore it. Not thread-safe against concurrent queries.
+    // Models whose answers change here must call markChanged().
+    virtual void advanceTo(double timeSeconds) { (void)timeSeconds; }
+
+    // Incremented whenever advanceTo() changed what the altitude-only queries
+    // return (always 0 for static models). Anything that caches query results
+    // (AtmosphereSampler, the simulation's force cache) compares it to know
+    // when those results went stale.
+    std::uint64_t generation() const { return stateGeneration; }
+
+    // Diagnostics: getPropertiesBatch() queries that landed in "space"
+    // (density below VACUUM_DENSITY) since the last call, then reset. Each
+    // batch adds its total with one relaxed atomic, so a model can be queried
+    // from several threads at once. Scalar queries (getProperties, getState,
+    // get*()) are not counted: an atomic per query would have every thread
+    // fighting over one cache line; callers that need it compare the density
+    // with VACUUM_DENSITY themselves. Poll / log this off the hot path (e.g.
+    // per frame or at the end of a run) instead of printing from inside a query.
+    std::uint64_t takeVacuumQueryCount() const
+    {
+        return vacuumQueries.exchange(0, std::memory_order_relaxed);
+    }
+
+    // 1e-6 of sea-level density: "atmosphere considered negligible"
+    static constexpr double VACUUM_DENSITY = 1.225e-6; // kg/m^3
+
+protected:
+    void markChanged() { ++stateGeneration; }
+
+    void countVacuumQueries(std::uint64_t count) const
+    {
+        if (count != 0)
+            vacuumQueries.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    std::uint64_t stateGeneration = 0;
+    mutable std::atomic<std::uint64_t> vacuumQueries{0};
 };
 
 
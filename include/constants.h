@@ -12,6 +12,20 @@ namespace constants {
 
     inline constexpr double GRAV_CONST = 6.67430e-11;
 
+    // Screen pixels are scaled by this factor (metres per pixel) before
+    // evaluating gravity, so planet-sized masses give pixel-sized motion.
+    inline constexpr double DISTANCE_SCALE = 1.0e5;
+    // G / DISTANCE_SCALE^2: lets the kernels work on raw pixel distances
+    inline constexpr double GRAV_CONST_SCALED = GRAV_CONST / (DISTANCE_SCALE * DISTANCE_SCALE);
+    // With that scaling an acceleration of 1 pixel/tick^2 is 1 m/s^2, which
+    // makes one tick sqrt(DISTANCE_SCALE) seconds. Velocities in pixels/tick
+    // times VELOCITY_SCALE are m/s (used by drag, which needs real speeds).
+    inline constexpr double SECONDS_PER_TICK = 316.22776601683793; // sqrt(DISTANCE_SCALE)
+    inline constexpr double VELOCITY_SCALE = DISTANCE_SCALE / SECONDS_PER_TICK;
+
+    // Drag coefficient given to bodies that do not set one (typical satellite value)
+    inline constexpr float DEFAULT_DRAG_COEFFICIENT = 2.2f;
+
     inline float screenHeight = 1000.0f;
     inline float screenWidth = 1400.0f;
 }
@@ -19,6 +33,23 @@ namespace constants {
 
 enum class AtmosphereType {
     ISA,
+    TabulatedISA,   // ISA sampled into a lookup table (TabulatedAtmosphere)
+    US76,           // ISA below 86 km + US76 thermosphere table to 1000 km
+    SpaceWeather,   // US76 scaled by solar flux / geomagnetic indices (SpaceWeatherAtmosphere)
+};
+
+enum class GravitySolverType {
+    DirectSum,   // exact O(N^2) pair sum, the accuracy reference
+    SymmetricDirectSum, // exact, each pair evaluated once (Newton's third law)
+    SimdDirectSum, // direct sum with AVX2/AVX-512 kernels (rsqrt + Newton step)
+    BarnesHut,   // O(N log N) quadtree approximation
+};
+
+enum class IntegratorType {
+    Euler,            // semi-implicit Euler, 1st order (the original loop)
+    Leapfrog,         // drift-kick-drift, 2nd order symplectic
+    VelocityVerlet,   // kick-drift-kick, 2nd order symplectic
+    Yoshida4,         // 4th order symplectic, 3 force evaluations per step
 };
 
 
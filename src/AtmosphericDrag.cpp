@@ -0,0 +1,21 @@
+#include "AtmosphericDrag.h"
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+AtmosphericDrag::AtmosphericDrag(std::unique_ptr<Atmosphere> atmosphere, std::size_t centralBody)
+    : model(std::move(atmosphere)), central(centralBody)
+{
+    if (!model)
+        throw std::runtime_error("AtmosphericDrag needs an atmosphere model!");
+}
+
+//------------------------------------------------------------------------------
+void AtmosphericDrag::addAccelerations(const ParticleSystem& bodies, float* ax, float* ay, ThreadPool* pool) const
+{
+    const Atmosphere* atmosphere = model.get();
+    addAccelerationsWith(bodies, ax, ay, pool,
+                         [atmosphere](const double* altitudes, std::size_t count, double* T, double* P, double* rho)
+                         {
+                             atmosphere->getPropertiesBatch(altitudes, count, T, P, rho);
+                         });
+}
@@ -0,0 +1,15 @@
+#include "CircleMesh.h"
+#include "Object.h"   // PI
+#include <cmath>
+
+void tessellateCircle(Vec2 centre, float radius, int res, std::vector<Vec2>& fan)
+{
+    fan.clear();
+    fan.push_back(centre);
+
+    for(int i =0; i<=res; i++)
+    {
+        float angle = 2.0f * PI * (static_cast<float>(i) / res);
+        fan.push_back({centre.x + std::cos(angle)*radius, centre.y + std::sin(angle)*radius});
+    }
+}
@@ -0,0 +1,117 @@
+#include "DrawList.h"
+#include "ParticleSystem.h"
+#include "SimulationRunner.h"
+#include <algorithm>
+
+void DrawList::clear()
+{
+    for (std::vector<CircleInstance>& level : circles)
+        level.clear();
+    points.clear();
+    vertices.clear();
+    strips.clear();
+    culled = 0;
+}
+
+//------------------------------------------------------------------------------
+std::size_t DrawList::circleCount() const
+{
+    std::size_t count = 0;
+    for (const std::vector<CircleInstance>& level : circles)
+        count += level.size();
+    return count;
+}
+
+//------------------------------------------------------------------------------
+inline void DrawList::classify(const CircleInstance& c)
+{
+    const ViewTransform& v = currentView;
+    const float sx = v.toScreenX(c.x);
+    const float sy = v.toScreenY(c.y);
+    const float r = c.radius * v.scale;
+
+    // cull on the bounding square before any vertex work
+    if (sx + r < 0.0f || sx - r > v.width || sy + r < 0.0f || sy - r > v.height)
+    {
+        ++culled;
+        return;
+    }
+
+    if (r < CIRCLE_POINT_RADIUS)
+        points.push_back(c);
+    else
+        circles[circleLodLevel(r)].push_back(c);
+}
+
+//------------------------------------------------------------------------------
+void DrawList::addCircle(float x, float y, float radius, std::uint32_t color)
+{
+    classify({x, y, radius, color});
+}
+
+//------------------------------------------------------------------------------
+void DrawList::addLineStrip(const Vec2* line, std::size_t count, std::uint32_t color)
+{
+    addLineStrip(line, count, nullptr, 0, color);
+}
+
+//------------------------------------------------------------------------------
+void DrawList::addLineStrip(const Vec2* a, std::size_t countA, const Vec2* b, std::size_t countB,
+                            std::uint32_t color)
+{
+    const std::size_t count = countA + countB;
+    if (count < 2)
+        return;
+
+    const Vec2 start = countA > 0 ? a[0] : b[0];
+    float minX = start.x, maxX = start.x;
+    float minY = start.y, maxY = start.y;
+    auto grow = [&](const Vec2* line, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            minX = std::min(minX, line[i].x);
+            maxX = std::max(maxX, line[i].x);
+            minY = std::min(minY, line[i].y);
+            maxY = std::max(maxY, line[i].y);
+        }
+    };
+    grow(a, countA);
+    grow(b, countB);
+
+    const ViewTransform& v = currentView;
+    if (v.toScreenX(maxX) < 0.0f || v.toScreenX(minX) > v.width
+        || v.toScreenY(maxY) < 0.0f || v.toScreenY(minY) > v.height)
+    {
+        ++culled;
+        return;
+    }
+
+    strips.push_back({static_cast<std::uint32_t>(vertices.size()), static_cast<std::uint32_t>(count), color});
+    vertices.insert(vertices.end(), a, a + countA);
+    vertices.insert(vertices.end(), b, b + countB);
+}
+
+//------------------------------------------------------------------------------
+void DrawList::addBodies(const ParticleSystem& bodies, std::uint32_t color)
+{
+    const float* x = bodies.x.data();
+    const float* y = bodies.y.data();
+    const float* radius = bodies.radius.data();
+
+    for (std::size_t i = 0; i < bodies.size(); ++i)
+        classify({x[i], y[i], radius[i], color});
+}
+
+//------------------------------------------------------------------------------
+void DrawList::addBodies(const SimulationSnapshot& snapshot, float blend, std::uint32_t color)
+{
+    const float* x0 = snapshot.previousX.data();
+    const float* y0 = snapshot.previousY.data();
+    const float* x1 = snapshot.x.data();
+    const float* y1 = snapshot.y.data();
+    const float* radius = snapshot.radius.data();
+
+    for (std::size_t i = 0; i < snapshot.size(); ++i)
+        classify({x0[i] + (x1[i] - x0[i]) * blend, y0[i] + (y1[i] - y0[i]) * blend, radius[i], color});
+}
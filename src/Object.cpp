@@ -1,80 +1,76 @@
 #include "Object.h"
-#include <vector>
-#include <iostream>
-#include <GLFW/glfw3.h>
+#include "ParticleSystem.h"
 
-Object::Object(){
-    std::cout << "Object initiated at 0,0" << std::endl;
-    this->position = std::vector<float> {0,0};
-    this->velocity = std::vector<float> {0,0};
-    this->radius = 10;
-
-}
-
-Object::Object(std::vector<float> position, std::vector<float> velocity,float mass, float radius){
-this->position = position;
-this->velocity = velocity;
-this->radius = radius;
-this->mass = mass;
+Object::Object(ParticleSystem& system, std::size_t index){
+    this->system = &system;
+    this->idx = index;
 }
 
-void Object::accelerate(float ax, float ay){
-    this->velocity[0] += ax;
-    this->velocity[1] += ay;
-};
+float& Object::x() const      { return system->x[idx]; }
+float& Object::y() const      { return system->y[idx]; }
+float& Object::vx() const     { return system->vx[idx]; }
+float& Object::vy() const     { return system->vy[idx]; }
+float& Object::mass() const   { return system->mass[idx]; }
+float& Object::radius() const { return system->radius[idx]; }
+float& Object::dragCoefficient() const { return system->dragCoefficient[idx]; }
 
+Vec2 Object::position() const { return {x(), y()}; }
+Vec2 Object::velocity() const { return {vx(), vy()}; }
 
-void Object::updatePos(){
-    this->position[0] += this->velocity[0];
-    this->position[1] += this->velocity[1];
+void Object::setPosition(Vec2 p){
+    this->x() = p.x;
+    this->y() = p.y;
 }
 
-void Object::DrawCircle(int res =100)
-{
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2d(this->position[0],this->position[1]);
-
-    for(int i =0; i<=res; i++)
-    {
-        float angle = 2.0f * PI * (static_cast<float>(i) / res);
-        float x = this->position[0] + cos(angle)*this->radius;
-        float y =this->position[1] + sin(angle)*this->radius;
-        glVertex2d(x,y);
+void Object::setVelocity(Vec2 v){
+    this->vx() = v.x;
+    this->vy() = v.y;
+}
 
-    }
-    glEnd();
+void Object::accelerate(Vec2 acceleration, float dt){
+    setVelocity(velocity() + acceleration * dt);
 };
 
 
+void Object::updatePos(float dt){
+    setPosition(position() + velocity() * dt);
+}
+
 void Object::checkCollisionWithScreen(float screenWidth, float screenHeight)
 {
+    float& px = this->x();
+    float& py = this->y();
+    float& pvx = this->vx();
+    float& pvy = this->vy();
+    const float r = this->radius();
+
     // Check vertical bounds
-    if (this->position[1] - this->radius < 0)
+    if (py - r < 0)
     {
         // If the bottom of the circle is below 0, reposition it at the bottom boundary.
-        this->position[1] = this->radius;
-        this->velocity[1] *= -0.95;
+        py = r;
+        pvy *= -0.95;
     }
 
-    else if (this->position[1] + this->radius > screenHeight)
+    else if (py + r > screenHeight)
     {
         // If the top of the circle is above the screen height, reposition it at the top boundary.
-        this->position[1] = screenHeight - this->radius;
-        this->velocity[1] *= -0.95;
+        py = screenHeight - r;
+        pvy *= -0.95;
     }
 
 
     // Check horizontal bounds
-    if (this->position[0] - this->radius < 0)
+    if (px - r < 0)
     {
         // If the left of the circle is off the screen, reposition it.
-        this->position[0] = this->radius;
-        this->velocity[0] *= -0.95;
+        px = r;
+        pvx *= -0.95;
     }
-    else if (this->position[0] + this->radius > screenWidth)
+    else if (px + r > screenWidth)
     {
         // If the right of the circle is off the screen, reposition it.
-        this->position[0] = screenWidth - this->radius;
-        this->velocity[0] *= -0.95;
+        px = screenWidth - r;
+        pvx *= -0.95;
     }
-};
\ No newline at end of file
+};
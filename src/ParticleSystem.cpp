@@ -0,0 +1,40 @@
+#include "ParticleSystem.h"
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+{
+    reserve(capacity);
+}
+
+std::size_t ParticleSystem::addBody(float px, float py, float pvx, float pvy, float m, float r, float cd)
+{
+    x.push_back(px);
+    y.push_back(py);
+    vx.push_back(pvx);
+    vy.push_back(pvy);
+    mass.push_back(m);
+    radius.push_back(r);
+    dragCoefficient.push_back(cd);
+    return x.size() - 1;
+}
+
+void ParticleSystem::reserve(std::size_t capacity)
+{
+    x.reserve(capacity);
+    y.reserve(capacity);
+    vx.reserve(capacity);
+    vy.reserve(capacity);
+    mass.reserve(capacity);
+    radius.reserve(capacity);
+    dragCoefficient.reserve(capacity);
+}
+
+void ParticleSystem::clear()
+{
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    mass.clear();
+    radius.clear();
+    dragCoefficient.clear();
+}
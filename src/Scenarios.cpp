@@ -0,0 +1,42 @@
+#include "Scenarios.h"
+#include "ParticleSystem.h"
+#include "constants.h"
+#include <cmath>
+#include <random>
+
+namespace scenarios {
+
+    void addEarthMoon(ParticleSystem& particles)
+    {
+        particles.addBody(constants::screenWidth/2, constants::screenHeight/2, 0, 0, 5.972e24f, 20);
+        particles.addBody(2*constants::screenWidth/3, constants::screenHeight/2, 0, -10, 7.35e22f, 5);
+    }
+
+    void addOrbitingDisk(ParticleSystem& particles, std::size_t count, unsigned seed)
+    {
+        const float cx = constants::screenWidth / 2;
+        const float cy = constants::screenHeight / 2;
+        const float centralMass = 5.972e24f;
+        const float innerRadius = 40.0f;
+        const float outerRadius = 0.45f * constants::screenHeight;
+
+        particles.reserve(particles.size() + count + 1);
+        particles.addBody(cx, cy, 0, 0, centralMass, 20);
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> angle(0.0f, 2.0f * static_cast<float>(PI));
+        std::uniform_real_distribution<float> radius(innerRadius, outerRadius);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float a = angle(rng);
+            const float r = radius(rng);
+            // circular speed around the central body: v = sqrt(G*M / r) (pixel units)
+            const float v = std::sqrt(static_cast<float>(constants::GRAV_CONST_SCALED) * centralMass / r);
+            particles.addBody(cx + r * std::cos(a), cy + r * std::sin(a),
+                              -v * std::sin(a), v * std::cos(a),
+                              1.0e18f, 1.0f);
+        }
+    }
+
+}
@@ -0,0 +1,95 @@
+#include "Simulation.h"
+#include "Integrators.h"
+#include "ThreadPool.h"
+#include "constants.h"
+
+Simulation::Simulation(std::unique_ptr<GravitySolver> gravity,
+                       ThreadPool* pool,
+                       std::unique_ptr<Integrator> integrator)
+    : gravity(std::move(gravity)), pool(pool)
+{
+    this->gravity->setThreadPool(pool);
+    setIntegrator(std::move(integrator));
+}
+
+//------------------------------------------------------------------------------
+void Simulation::setIntegrator(std::unique_ptr<Integrator> integrator)
+{
+    if (!integrator)
+        integrator = std::make_unique<VelocityVerletIntegrator>();
+    this->integrator = std::move(integrator);
+}
+
+//------------------------------------------------------------------------------
+void Simulation::setDrag(std::unique_ptr<AtmosphericDrag> drag)
+{
+    dragForce = std::move(drag);
+    accValid = false;
+}
+
+//------------------------------------------------------------------------------
+void Simulation::step(float dt)
+{
+    // time-dependent atmospheres prepare this step's coefficients once, here;
+    // if that changed the air, the cached drag (and so a(t)) is stale
+    if (dragForce)
+    {
+        Atmosphere& air = dragForce->atmosphere();
+        const std::uint64_t generation = air.generation();
+        air.advanceTo(simTime * constants::SECONDS_PER_TICK);
+        if (air.generation() != generation)
+            accValid = false;
+    }
+    integrator->step(*this, dt);
+    simTime += dt;
+}
+
+//------------------------------------------------------------------------------
+void Simulation::computeAccelerations()
+{
+    const std::size_t n = bodies.size();
+    ax.resize(n);
+    ay.resize(n);
+    gravity->computeAccelerations(bodies, ax.data(), ay.data());
+    // drag is its own parallel pass over the bodies, right after gravity
+    if (dragForce)
+        dragForce->addAccelerations(bodies, ax.data(), ay.data(), pool);
+    accValid = true;
+}
+
+//------------------------------------------------------------------------------
+void Simulation::kick(float h)
+{
+    float* vx = bodies.vx.data();
+    float* vy = bodies.vy.data();
+    const float* accX = ax.data();
+    const float* accY = ay.data();
+
+    parallelFor(pool, bodies.size(), [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            vx[i] += accX[i] * h;
+            vy[i] += accY[i] * h;
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+void Simulation::drift(float h)
+{
+    float* x = bodies.x.data();
+    float* y = bodies.y.data();
+    const float* vx = bodies.vx.data();
+    const float* vy = bodies.vy.data();
+
+    parallelFor(pool, bodies.size(), [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            x[i] += vx[i] * h;
+            y[i] += vy[i] * h;
+        }
+    });
+    accValid = false;
+}
@@ -0,0 +1,121 @@
+#include "SimulationRunner.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    // A runner that falls further behind than this (a breakpoint, a slow
+    // machine) drops the missed steps instead of racing to catch up.
+    constexpr double MAX_LAG_SECONDS = 0.25;
+}
+
+//------------------------------------------------------------------------------
+float SimulationSnapshot::blendFactor(Clock::time_point now) const
+{
+    if (stepInterval <= 0.0)
+        return 1.0f;
+    const double elapsed = std::chrono::duration<double>(now - published).count();
+    return static_cast<float>(std::clamp(elapsed / stepInterval, 0.0, 1.0));
+}
+
+//------------------------------------------------------------------------------
+SimulationRunner::SimulationRunner(Simulation& simulation, double stepsPerSecond, float dt)
+    : simulation(simulation), stepsPerSecond(stepsPerSecond), dt(dt)
+{
+}
+
+//------------------------------------------------------------------------------
+SimulationRunner::~SimulationRunner()
+{
+    stop();
+}
+
+//------------------------------------------------------------------------------
+void SimulationRunner::start()
+{
+    if (running())
+        throw std::runtime_error("SimulationRunner is already running!");
+
+    // the current state, so the renderer has something before the first step
+    SimulationSnapshot& first = snapshots.writeBuffer();
+    captureStart(first);
+    captureEnd(first, 0);
+    snapshots.publish();
+
+    stopRequested.store(false, std::memory_order_relaxed);
+    worker = std::thread(&SimulationRunner::run, this);
+}
+
+//------------------------------------------------------------------------------
+void SimulationRunner::stop()
+{
+    if (!running())
+        return;
+    stopRequested.store(true, std::memory_order_relaxed);
+    worker.join();
+}
+
+//------------------------------------------------------------------------------
+const SimulationSnapshot& SimulationRunner::latest()
+{
+    snapshots.update();
+    return snapshots.readBuffer();
+}
+
+//------------------------------------------------------------------------------
+void SimulationRunner::run()
+{
+    using Clock = SimulationSnapshot::Clock;
+    const bool paced = stepsPerSecond > 0.0;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(paced ? 1.0 / stepsPerSecond : 0.0));
+    const auto maxLag = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(MAX_LAG_SECONDS));
+
+    std::uint64_t steps = 0;
+    Clock::time_point next = Clock::now();
+
+    while (!stopRequested.load(std::memory_order_relaxed))
+    {
+        SimulationSnapshot& snapshot = snapshots.writeBuffer();
+        captureStart(snapshot);
+        simulation.step(dt);
+        captureEnd(snapshot, ++steps);
+        snapshots.publish();
+
+        if (!paced)
+            continue;
+
+        next += interval;
+        const Clock::time_point now = Clock::now();
+        if (now < next)
+            std::this_thread::sleep_until(next);
+        else if (now - next > maxLag)
+            next = now;
+    }
+}
+
+//------------------------------------------------------------------------------
+void SimulationRunner::captureStart(SimulationSnapshot& snapshot) const
+{
+    const ParticleSystem& bodies = std::as_const(simulation).particles();   // read only: keeps the force cache
+    const std::size_t n = bodies.size();
+    snapshot.previousX.assign(bodies.x.data(), bodies.x.data() + n);
+    snapshot.previousY.assign(bodies.y.data(), bodies.y.data() + n);
+}
+
+//------------------------------------------------------------------------------
+void SimulationRunner::captureEnd(SimulationSnapshot& snapshot, std::uint64_t steps) const
+{
+    const ParticleSystem& bodies = std::as_const(simulation).particles();
+    const std::size_t n = bodies.size();
+    snapshot.x.assign(bodies.x.data(), bodies.x.data() + n);
+    snapshot.y.assign(bodies.y.data(), bodies.y.data() + n);
+    snapshot.radius.assign(bodies.radius.data(), bodies.radius.data() + n);
+
+    snapshot.time = simulation.time();
+    snapshot.steps = steps;
+    snapshot.stepInterval = stepsPerSecond > 0.0 ? 1.0 / stepsPerSecond : 0.0;
+    snapshot.published = SimulationSnapshot::Clock::now();
+}
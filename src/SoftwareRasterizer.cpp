@@ -0,0 +1,263 @@
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+namespace
+{
+    // floor() to int for coordinates that may lie far outside the frame
+    // (e.g. the far end of a trail), clamped to [lo, hi] before the cast
+    int floorClamped(float v, int lo, int hi)
+    {
+        return static_cast<int>(std::floor(std::clamp(v, static_cast<float>(lo), static_cast<float>(hi))));
+    }
+
+    // Liang-Barsky clip of a -> b against [minX, maxX] x [minY, maxY], in
+    // double so segments reaching far off-frame keep their slope. False if
+    // nothing is left.
+    bool clipSegment(double& ax, double& ay, double& bx, double& by,
+                     double minX, double minY, double maxX, double maxY)
+    {
+        const double dx = bx - ax;
+        const double dy = by - ay;
+        double t0 = 0.0, t1 = 1.0;
+        const double p[4] = {-dx, dx, -dy, dy};
+        const double q[4] = {ax - minX, maxX - ax, ay - minY, maxY - ay};
+        for (int k = 0; k < 4; ++k)
+        {
+            if (p[k] == 0.0)
+            {
+                if (q[k] < 0.0) return false;
+                continue;
+            }
+            const double t = q[k] / p[k];
+            if (p[k] < 0.0) t0 = std::max(t0, t);
+            else            t1 = std::min(t1, t);
+            if (t0 > t1) return false;
+        }
+        const double x0 = ax, y0 = ay;
+        ax = x0 + t0 * dx;  ay = y0 + t0 * dy;
+        bx = x0 + t1 * dx;  by = y0 + t1 * dy;
+        return true;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void writePpm(std::ostream& out, const Framebuffer& frame)
+{
+    out << "P6\n" << frame.width << ' ' << frame.height << "\n255\n";
+    std::vector<char> row(static_cast<std::size_t>(frame.width) * 3);
+    for (int y = frame.height - 1; y >= 0; --y)
+    {
+        for (int x = 0; x < frame.width; ++x)
+        {
+            const std::uint32_t c = frame.at(x, y);
+            row[3 * x]     = static_cast<char>(c & 0xff);
+            row[3 * x + 1] = static_cast<char>((c >> 8) & 0xff);
+            row[3 * x + 2] = static_cast<char>((c >> 16) & 0xff);
+        }
+        out.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+}
+
+//------------------------------------------------------------------------------
+void writeRawRgba(std::ostream& out, const Framebuffer& frame)
+{
+    // pixels are already R, G, B, A in memory; only the row order flips
+    const std::streamsize rowBytes = static_cast<std::streamsize>(frame.width) * 4;
+    for (int y = frame.height - 1; y >= 0; --y)
+        out.write(reinterpret_cast<const char*>(&frame.pixels[static_cast<std::size_t>(y) * frame.width]), rowBytes);
+}
+
+//------------------------------------------------------------------------------
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, ThreadPool* pool)
+    : pool(pool)
+{
+    if (width <= 0 || height <= 0)
+        throw std::runtime_error("SoftwareRasterizer needs a positive frame size!");
+
+    frame.width = width;
+    frame.height = height;
+    frame.pixels.assign(static_cast<std::size_t>(width) * height, background);
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    tileItems.resize(static_cast<std::size_t>(tilesX) * tilesY);
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::draw(const DrawList& list)
+{
+    bin(list);
+    parallelFor(pool, tileItems.size(), [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t tile = begin; tile < end; ++tile)
+            drawTile(static_cast<int>(tile));
+    });
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::bin(const DrawList& list)
+{
+    for (std::vector<std::uint32_t>& items : tileItems)
+        items.clear();
+    segments.clear();
+    discs.clear();
+
+    const ViewTransform& v = list.view();
+    // the frame may differ in size from the list's viewport: stretch to fit,
+    // like a resized window
+    const float fx = frame.width / v.width;
+    const float fy = frame.height / v.height;
+    auto toFrameX = [&](float x) { return v.toScreenX(x) * fx; };
+    auto toFrameY = [&](float y) { return v.toScreenY(y) * fy; };
+
+    // lines first (drawn underneath), then circles coarse to fine, then
+    // points; segments are clipped to (just beyond) the frame up front
+    const std::vector<Vec2>& vertices = list.lineVertices();
+    for (const LineStrip& strip : list.lineStrips())
+        for (std::uint32_t k = strip.first + 1; k < strip.first + strip.count; ++k)
+        {
+            double ax = toFrameX(vertices[k - 1].x), ay = toFrameY(vertices[k - 1].y);
+            double bx = toFrameX(vertices[k].x), by = toFrameY(vertices[k].y);
+            if (clipSegment(ax, ay, bx, by, -1.0, -1.0, frame.width + 1.0, frame.height + 1.0))
+                segments.push_back({static_cast<float>(ax), static_cast<float>(ay),
+                                    static_cast<float>(bx), static_cast<float>(by), strip.color});
+        }
+
+    const float radiusScale = v.scale * std::max(fx, fy);
+    for (int level = 0; level < CIRCLE_LOD_LEVELS; ++level)
+        for (const CircleInstance& c : list.circleInstances(level))
+            discs.push_back({toFrameX(c.x), toFrameY(c.y), c.radius * radiusScale, c.color});
+    for (const CircleInstance& c : list.pointInstances())
+        discs.push_back({toFrameX(c.x), toFrameY(c.y), 0.0f, c.color});
+
+    const std::uint32_t firstDisc = static_cast<std::uint32_t>(segments.size());
+    for (std::uint32_t i = 0; i < segments.size(); ++i)
+    {
+        const Segment& s = segments[i];
+        binBounds(std::min(s.x0, s.x1), std::min(s.y0, s.y1), std::max(s.x0, s.x1), std::max(s.y0, s.y1), i);
+    }
+    for (std::uint32_t i = 0; i < discs.size(); ++i)
+    {
+        const Disc& d = discs[i];
+        binBounds(d.x - d.radius, d.y - d.radius, d.x + d.radius, d.y + d.radius, firstDisc + i);
+    }
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::binBounds(float minX, float minY, float maxX, float maxY, std::uint32_t item)
+{
+    // pixel bounds, clamped to the frame (off-frame items land in no tile)
+    const int px0 = floorClamped(minX, 0, frame.width);
+    const int py0 = floorClamped(minY, 0, frame.height);
+    const int px1 = floorClamped(maxX, -1, frame.width - 1);
+    const int py1 = floorClamped(maxY, -1, frame.height - 1);
+    if (px0 > px1 || py0 > py1)
+        return;
+
+    for (int ty = py0 / TILE_SIZE; ty <= py1 / TILE_SIZE; ++ty)
+        for (int tx = px0 / TILE_SIZE; tx <= px1 / TILE_SIZE; ++tx)
+            tileItems[static_cast<std::size_t>(ty) * tilesX + tx].push_back(item);
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::drawTile(int tile)
+{
+    const int x0 = (tile % tilesX) * TILE_SIZE;
+    const int y0 = (tile / tilesX) * TILE_SIZE;
+    const int x1 = std::min(x0 + TILE_SIZE, frame.width);    // exclusive
+    const int y1 = std::min(y0 + TILE_SIZE, frame.height);
+
+    for (int y = y0; y < y1; ++y)
+        std::fill(&frame.at(x0, y), &frame.at(x0, y) + (x1 - x0), background);
+
+    const std::uint32_t firstDisc = static_cast<std::uint32_t>(segments.size());
+    for (std::uint32_t item : tileItems[tile])
+    {
+        if (item < firstDisc)
+            drawSegment(segments[item], x0, y0, x1, y1);
+        else
+            drawDisc(discs[item - firstDisc], x0, y0, x1, y1);
+    }
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::drawDisc(const Disc& d, int x0, int y0, int x1, int y1)
+{
+    if (d.radius <= 0.0f)
+    {
+        // a point covers the pixel it falls in
+        const int px = floorClamped(d.x, x0 - 1, x1);
+        const int py = floorClamped(d.y, y0 - 1, y1);
+        if (px >= x0 && px < x1 && py >= y0 && py < y1)
+            frame.at(px, py) = d.color;
+        return;
+    }
+
+    // every pixel whose centre lies inside the circle, row by row
+    const float r2 = d.radius * d.radius;
+    const int rowBegin = -floorClamped(-(d.y - d.radius - 0.5f), -y1, -y0);   // ceil
+    const int rowEnd = floorClamped(d.y + d.radius - 0.5f, y0 - 1, y1 - 1);
+    for (int y = rowBegin; y <= rowEnd; ++y)
+    {
+        const float dy = (y + 0.5f) - d.y;
+        if (dy * dy > r2)
+            continue;
+        const float half = std::sqrt(r2 - dy * dy);
+        const int spanBegin = -floorClamped(-(d.x - half - 0.5f), -x1, -x0);   // ceil
+        const int spanEnd = floorClamped(d.x + half - 0.5f, x0 - 1, x1 - 1);
+        if (spanBegin <= spanEnd)
+            std::fill(&frame.at(spanBegin, y), &frame.at(spanEnd, y) + 1, d.color);
+    }
+}
+
+//------------------------------------------------------------------------------
+void SoftwareRasterizer::drawSegment(const Segment& s, int x0, int y0, int x1, int y1)
+{
+    // one-pixel line: step along the longer axis, one pixel per column (or
+    // row), only over the part that crosses this tile
+    const float dx = s.x1 - s.x0;
+    const float dy = s.y1 - s.y0;
+
+    if (std::fabs(dx) >= std::fabs(dy))
+    {
+        if (dx == 0.0f)
+        {
+            const int px = floorClamped(s.x0, x0 - 1, x1);
+            const int py = floorClamped(s.y0, y0 - 1, y1);
+            if (px >= x0 && px < x1 && py >= y0 && py < y1)
+                frame.at(px, py) = s.color;
+            return;
+        }
+        const float slope = dy / dx;
+        const float left = std::min(s.x0, s.x1);
+        const float right = std::max(s.x0, s.x1);
+        const int begin = floorClamped(left, x0, x1);
+        const int end = floorClamped(right, x0 - 1, x1 - 1);
+        for (int x = begin; x <= end; ++x)
+        {
+            const float cx = std::clamp(x + 0.5f, left, right);
+            const int y = floorClamped(s.y0 + (cx - s.x0) * slope, y0 - 1, y1);
+            if (y >= y0 && y < y1)
+                frame.at(x, y) = s.color;
+        }
+    }
+    else
+    {
+        const float slope = dx / dy;
+        const float bottom = std::min(s.y0, s.y1);
+        const float top = std::max(s.y0, s.y1);
+        const int begin = floorClamped(bottom, y0, y1);
+        const int end = floorClamped(top, y0 - 1, y1 - 1);
+        for (int y = begin; y <= end; ++y)
+        {
+            const float cy = std::clamp(y + 0.5f, bottom, top);
+            const int x = floorClamped(s.x0 + (cy - s.y0) * slope, x0 - 1, x1);
+            if (x >= x0 && x < x1)
+                frame.at(x, y) = s.color;
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace
+{
+    // Chunks handed out per thread; more than one so a thread that finishes
+    // early (e.g. a sparse part of the Barnes–Hut tree) can pick up more work.
+    constexpr std::size_t CHUNKS_PER_THREAD = 4;
+}
+
+//------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0) threadCount = 1;
+    workers.reserve(threadCount - 1);
+    for (unsigned i = 1; i < threadCount; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+//------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+//------------------------------------------------------------------------------
+void ThreadPool::run(std::size_t count, RangeFn fn, void* ctx)
+{
+    if (count == 0) return;
+
+    const std::size_t chunks = size() * CHUNKS_PER_THREAD;
+    const std::size_t chunk = std::max<std::size_t>(1, (count + chunks - 1) / chunks);
+
+    if (workers.empty() || chunk >= count)
+    {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobFn = fn;
+        jobCtx = ctx;
+        jobCount = count;
+        jobChunk = chunk;
+        nextChunk.store(0, std::memory_order_relaxed);
+        busyWorkers = static_cast<unsigned>(workers.size());
+        ++generation;
+    }
+    wakeWorkers.notify_all();
+
+    // the calling thread works too, then waits for the stragglers
+    workOnChunks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] { return busyWorkers == 0; });
+    jobFn = nullptr;
+    jobCtx = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void ThreadPool::workOnChunks()
+{
+    while (true)
+    {
+        const std::size_t begin = nextChunk.fetch_add(jobChunk, std::memory_order_relaxed);
+        if (begin >= jobCount) return;
+        const std::size_t end = std::min(begin + jobChunk, jobCount);
+        jobFn(jobCtx, begin, end);
+    }
+}
+
+//------------------------------------------------------------------------------
+void ThreadPool::workerLoop()
+{
+    unsigned long long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        workOnChunks();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = (--busyWorkers == 0);
+        }
+        if (last) jobDone.notify_one();
+    }
+}
@@ -0,0 +1,116 @@
+#include "TrailBuffer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+TrailBuffer::TrailBuffer(std::size_t capacity, unsigned stride, float bendTolerance)
+    : cap(capacity), stride(stride), bendTolerance(bendTolerance)
+{
+    if (capacity < 2)
+        throw std::runtime_error("TrailBuffer needs room for at least two points!");
+    if (stride < 1)
+        throw std::runtime_error("TrailBuffer stride must be at least one!");
+}
+
+//------------------------------------------------------------------------------
+void TrailBuffer::resize(std::size_t bodyCount)
+{
+    points.assign(bodyCount * cap, Vec2{});
+    head.assign(bodyCount, 0);
+    count.assign(bodyCount, 0);
+    age.assign(bodyCount, 0);
+}
+
+//------------------------------------------------------------------------------
+void TrailBuffer::clear()
+{
+    std::fill(count.begin(), count.end(), 0);
+    std::fill(age.begin(), age.end(), 0);
+}
+
+//------------------------------------------------------------------------------
+std::size_t TrailBuffer::memoryBytes() const
+{
+    return points.size() * sizeof(Vec2)
+           + (head.size() + count.size() + age.size()) * sizeof(std::uint32_t);
+}
+
+//------------------------------------------------------------------------------
+void TrailBuffer::record(const float* x, const float* y, std::size_t bodyCount, ThreadPool* pool)
+{
+    if (bodyCount != head.size())
+        resize(bodyCount);
+
+    // every body only touches its own slice of the arena
+    parallelFor(pool, bodyCount, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            recordBody(i, {x[i], y[i]});
+    });
+}
+
+//------------------------------------------------------------------------------
+void TrailBuffer::recordBody(std::size_t body, Vec2 p)
+{
+    Vec2* ring = points.data() + body * cap;
+    std::uint32_t& h = head[body];
+    std::uint32_t& n = count[body];
+
+    if (n == 0)
+    {
+        // first sample: one kept point plus the live one, both here
+        ring[h] = p;
+        h = static_cast<std::uint32_t>((h + 1) % cap);
+        ring[h] = p;
+        n = 2;
+        age[body] = 0;
+        return;
+    }
+
+    ring[h] = p;   // the live point follows the body
+    ++age[body];
+
+    bool keep = age[body] >= stride;
+    if (!keep && n >= 3)
+    {
+        // distance of p from the line through the last two kept points
+        const Vec2 a = ring[(h + cap - 2) % cap];
+        const Vec2 b = ring[(h + cap - 1) % cap];
+        const Vec2 dir = b - a;
+        const float len2 = dir.lengthSquared();
+        if (len2 > 0.0f)
+        {
+            const Vec2 d = p - a;
+            const float cross = dir.x * d.y - dir.y * d.x;
+            keep = cross * cross > bendTolerance * bendTolerance * len2;
+        }
+    }
+
+    if (keep)
+    {
+        // p becomes a kept point; a new live point starts on top of it,
+        // overwriting the oldest once the ring is full
+        h = static_cast<std::uint32_t>((h + 1) % cap);
+        ring[h] = p;
+        if (n < cap)
+            ++n;
+        age[body] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void TrailBuffer::addTo(DrawList& list, std::uint32_t color) const
+{
+    for (std::size_t i = 0; i < head.size(); ++i)
+    {
+        const std::size_t n = count[i];
+        if (n < 2)
+            continue;
+
+        // the ring holds the trail in (at most) two contiguous pieces
+        const Vec2* ring = points.data() + i * cap;
+        const std::size_t first = (head[i] + cap - n + 1) % cap;
+        const std::size_t firstPiece = std::min(n, cap - first);
+        list.addLineStrip(ring + first, firstPiece, ring, n - firstPiece, color);
+    }
+}
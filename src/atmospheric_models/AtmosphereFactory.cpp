@@ -1,6 +1,9 @@
 
 #include "AtmosphereFactory.h"
 #include "ISA_atmosphere.h"
+#include "TabulatedAtmosphere.h"
+#include "US76_atmosphere.h"
+#include "SpaceWeatherAtmosphere.h"
 #include <stdexcept>
 
 std::unique_ptr<Atmosphere> AtmosphereFactory::createAtmosphere(AtmosphereType type)
@@ -8,8 +11,24 @@ std::unique_ptr<Atmosphere> AtmosphereFactory::createAtmosphere(AtmosphereType t
     switch (type) {
         case AtmosphereType::ISA:
             return std::make_unique<ISA_atmosphere>();
+        case AtmosphereType::TabulatedISA:
+            return std::make_unique<TabulatedAtmosphere>(std::make_unique<ISA_atmosphere>());
+        case AtmosphereType::US76:
+            return std::make_unique<US76_atmosphere>();
+        case AtmosphereType::SpaceWeather:
+            // constant moderate activity; pass a CSV (overload below) for real indices
+            return std::make_unique<SpaceWeatherAtmosphere>();
         default:
             throw std::runtime_error("Unknown AtmosphereType!");
 
     }
-}
\ No newline at end of file
+}
+
+std::unique_ptr<Atmosphere> AtmosphereFactory::createAtmosphere(AtmosphereType type, const std::string& spaceWeatherCsv)
+{
+    if (spaceWeatherCsv.empty())
+        return createAtmosphere(type);
+    if (type != AtmosphereType::SpaceWeather)
+        throw std::runtime_error("Only AtmosphereType::SpaceWeather reads a space weather file!");
+    return std::make_unique<SpaceWeatherAtmosphere>(SpaceWeatherTable::loadCsv(spaceWeatherCsv));
+}
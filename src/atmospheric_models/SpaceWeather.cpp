@@ -0,0 +1,120 @@
+#include "SpaceWeather.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    // Standard Kp <-> ap conversion (Kp in thirds: 0, 0+, 1-, 1o, 1+, ...)
+    constexpr double AP_TABLE[] = {0, 2, 3, 4, 5, 6, 7, 9, 12, 15, 18, 22, 27, 32,
+                                   39, 48, 56, 67, 80, 94, 111, 132, 154, 179, 207, 236, 300, 400};
+    constexpr int AP_TABLE_SIZE = sizeof(AP_TABLE) / sizeof(AP_TABLE[0]);
+
+    // strtod on [begin, end) of a line, false if nothing numeric was there
+    bool parseField(const std::string& line, std::size_t& pos, double& value)
+    {
+        const char* start = line.c_str() + pos;
+        char* stop = nullptr;
+        value = std::strtod(start, &stop);
+        if (stop == start)
+            return false;
+        pos += static_cast<std::size_t>(stop - start);
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r'))
+            ++pos;
+        if (pos < line.size() && line[pos] == ',')
+            ++pos;
+        return true;
+    }
+}
+
+//------------------------------------------------------------------------------
+SpaceWeatherTable::SpaceWeatherTable()
+    : records(1)
+{
+}
+
+//------------------------------------------------------------------------------
+SpaceWeatherTable::SpaceWeatherTable(std::vector<SpaceWeatherRecord> records)
+    : records(std::move(records))
+{
+    if (this->records.empty())
+        throw std::runtime_error("SpaceWeatherTable needs at least one record!");
+    for (std::size_t i = 1; i < this->records.size(); ++i)
+        if (this->records[i].time < this->records[i - 1].time)
+            throw std::runtime_error("SpaceWeatherTable records must be sorted by time!");
+}
+
+//------------------------------------------------------------------------------
+SpaceWeatherTable SpaceWeatherTable::loadCsv(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Cannot open space weather file " + path);
+
+    std::vector<SpaceWeatherRecord> rows;
+    std::string line;
+    std::size_t lineNumber = 0;
+    bool headerAllowed = true;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        // a header is a first content line that does not start with a number
+        const bool numeric = std::isdigit(static_cast<unsigned char>(line[first]))
+                             || line[first] == '-' || line[first] == '+' || line[first] == '.';
+        const bool header = headerAllowed && !numeric;
+        headerAllowed = false;
+        if (header)
+            continue;
+
+        // exactly four numbers; anything left over (a fifth field, "12abc") is an error
+        SpaceWeatherRecord row;
+        std::size_t pos = first;
+        if (!parseField(line, pos, row.time) || !parseField(line, pos, row.f107)
+            || !parseField(line, pos, row.f107a) || !parseField(line, pos, row.ap)
+            || pos != line.size())
+            throw std::runtime_error("Malformed space weather line " + std::to_string(lineNumber) + " in " + path);
+        rows.push_back(row);
+    }
+
+    if (rows.empty())
+        throw std::runtime_error("No space weather records in " + path);
+    return SpaceWeatherTable(std::move(rows));
+}
+
+//------------------------------------------------------------------------------
+std::size_t SpaceWeatherTable::indexAt(double time, std::size_t hint) const
+{
+    std::size_t i = std::min(hint, records.size() - 1);
+    if (records[i].time > time)
+    {
+        // went backwards: binary search for the last record at or before time
+        auto it = std::upper_bound(records.begin(), records.end(), time,
+                                   [](double t, const SpaceWeatherRecord& r) { return t < r.time; });
+        return it == records.begin() ? 0 : static_cast<std::size_t>(it - records.begin()) - 1;
+    }
+    // usual case: time moves forward by one step, at most a few records
+    while (i + 1 < records.size() && records[i + 1].time <= time)
+        ++i;
+    return i;
+}
+
+//------------------------------------------------------------------------------
+double kpFromAp(double ap)
+{
+    if (!(ap > AP_TABLE[0]))
+        return 0.0;
+    for (int k = 1; k < AP_TABLE_SIZE; ++k)
+    {
+        if (ap <= AP_TABLE[k])
+        {
+            const double f = (ap - AP_TABLE[k - 1]) / (AP_TABLE[k] - AP_TABLE[k - 1]);
+            return (k - 1 + f) / 3.0;
+        }
+    }
+    return 9.0;
+}
@@ -0,0 +1,161 @@
+#include "SpaceWeatherAtmosphere.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double STRETCH_BASE = 120000.0;   // m, bottom of the stretched region
+    constexpr double T_AT_BASE = 360.0;         // K, US76 temperature at 120 km
+    constexpr double US76_EXO_TEMP = 1000.0;    // K, Tinf of the US76 tables
+
+    // Altitudes handed to the reference model per batch call.
+    constexpr std::size_t BATCH_CHUNK = 256;
+}
+
+//------------------------------------------------------------------------------
+SpaceWeatherAtmosphere::SpaceWeatherAtmosphere(SpaceWeatherTable weather)
+    : weather(std::move(weather))
+{
+    advanceTo(0.0);
+}
+
+//------------------------------------------------------------------------------
+SpaceWeatherAtmosphere::Coefficients SpaceWeatherAtmosphere::coefficientsFor(const SpaceWeatherRecord& indices)
+{
+    const double kp = kpFromAp(indices.ap);
+    const double tc = 379.0 + 3.24 * indices.f107a + 1.3 * (indices.f107 - indices.f107a);
+    double tInf = tc + 28.0 * kp + 0.03 * std::exp(kp);
+    tInf = std::max(tInf, T_AT_BASE + 1.0); // keep the profile rising above 120 km
+
+    Coefficients c;
+    c.exosphericTemperature = tInf;
+    c.stretch = US76_EXO_TEMP / tInf;
+    c.temperatureScale = (tInf - T_AT_BASE) / (US76_EXO_TEMP - T_AT_BASE);
+    return c;
+}
+
+//------------------------------------------------------------------------------
+void SpaceWeatherAtmosphere::advanceTo(double timeSeconds)
+{
+    cursor = weather.indexAt(timeSeconds, cursor);
+    const Coefficients next = coefficientsFor(weather[cursor]);
+    // within one table record nothing changes, so cached results stay valid
+    if (next.exosphericTemperature != current.exosphericTemperature)
+        markChanged();
+    current = next;
+    now = timeSeconds;
+}
+
+//------------------------------------------------------------------------------
+void SpaceWeatherAtmosphere::evaluate(double altitudeMeters, const Coefficients& c,
+                                      double &temperature, double &pressure, double &density) const
+{
+    if (!(altitudeMeters > STRETCH_BASE))
+    {
+        reference.evaluate(altitudeMeters, temperature, pressure, density);
+        return;
+    }
+
+    // US76 at the equivalent altitude of the stretched profile
+    const double equivalent = STRETCH_BASE + (altitudeMeters - STRETCH_BASE) * c.stretch;
+    double tRef;
+    reference.evaluate(equivalent, tRef, pressure, density);
+
+    // same composition as the reference point, hotter / colder gas
+    temperature = T_AT_BASE + (tRef - T_AT_BASE) * c.temperatureScale;
+    pressure *= temperature / tRef;
+}
+
+//------------------------------------------------------------------------------
+double SpaceWeatherAtmosphere::getTemperature(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return T;
+}
+
+//------------------------------------------------------------------------------
+double SpaceWeatherAtmosphere::getPressure(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return P;
+}
+
+//------------------------------------------------------------------------------
+double SpaceWeatherAtmosphere::getDensity(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return rho;
+}
+
+//------------------------------------------------------------------------------
+void SpaceWeatherAtmosphere::getProperties(double altitudeMeters,
+                                           double &temperature,
+                                           double &pressure,
+                                           double &density) const
+{
+    evaluate(altitudeMeters, current, temperature, pressure, density);
+}
+
+//------------------------------------------------------------------------------
+AtmosphereState SpaceWeatherAtmosphere::getState(double altitudeMeters) const
+{
+    double T, P, rho;
+    getProperties(altitudeMeters, T, P, rho);
+    return air::makeState(T, P, rho);
+}
+
+//------------------------------------------------------------------------------
+AtmosphereState SpaceWeatherAtmosphere::getState(double altitudeMeters,
+                                                 double timeSeconds,
+                                                 double latitude,
+                                                 double longitude) const
+{
+    (void)latitude;
+    (void)longitude;
+    const Coefficients c = (timeSeconds == now) ? current
+                                                : coefficientsFor(weather[weather.indexAt(timeSeconds, cursor)]);
+    double T, P, rho;
+    evaluate(altitudeMeters, c, T, P, rho);
+    return air::makeState(T, P, rho);
+}
+
+//------------------------------------------------------------------------------
+void SpaceWeatherAtmosphere::getPropertiesBatch(const double* altitudes,
+                                                std::size_t count,
+                                                double* temperature,
+                                                double* pressure,
+                                                double* density) const
+{
+    double equivalent[BATCH_CHUNK];
+    std::uint64_t spaceCount = 0;
+
+    for (std::size_t start = 0; start < count; start += BATCH_CHUNK)
+    {
+        const std::size_t n = std::min(BATCH_CHUNK, count - start);
+        const double* h = altitudes + start;
+        double* T   = temperature + start;
+        double* P   = pressure + start;
+        double* rho = density + start;
+
+        // 1) map onto the US76 profile and evaluate it in one batch
+        for (std::size_t i = 0; i < n; ++i)
+            equivalent[i] = h[i] > STRETCH_BASE ? STRETCH_BASE + (h[i] - STRETCH_BASE) * current.stretch : h[i];
+        reference.evaluateBatch(equivalent, n, T, P, rho);
+
+        // 2) rescale the temperature above 120 km
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (h[i] > STRETCH_BASE)
+            {
+                const double tRef = T[i];
+                T[i] = T_AT_BASE + (tRef - T_AT_BASE) * current.temperatureScale;
+                P[i] *= T[i] / tRef;
+            }
+            spaceCount += (rho[i] < VACUUM_DENSITY);
+        }
+    }
+    countVacuumQueries(spaceCount);
+}
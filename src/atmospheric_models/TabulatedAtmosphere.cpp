@@ -0,0 +1,281 @@
+#include "TabulatedAtmosphere.h"
+#include "TimeVaryingAtmosphere.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    // Samples per interval, at t = 0, 1/3, 2/3 and 1.
+    constexpr std::size_t FIT_POINTS = 4;
+
+    // Error search per interval (in the local coordinate t in [0, 1)): a first
+    // pass at COARSE_CHECKS evenly spread points plus two just inside the ends,
+    // then ZOOM_ROUNDS passes of ZOOM_POINTS points over a shrinking window
+    // around the worst point found so far. The zoom homes in on error peaks
+    // that sit between the coarse points, e.g. right next to a jump of the
+    // source inside an interval.
+    constexpr std::size_t COARSE_CHECKS = 16;
+    constexpr double END_OFFSET = 1e-6;
+    constexpr int ZOOM_ROUNDS = 4;
+    constexpr std::size_t ZOOM_POINTS = 8;
+
+    double relativeError(double approx, double exact)
+    {
+        const double scale = std::max(std::abs(exact), std::numeric_limits<double>::min());
+        return std::abs(approx - exact) / scale;
+    }
+
+    // Cubic through (0, y0), (1/3, y1), (2/3, y2), (1, y3) in power form.
+    void fitCubic(const double y[FIT_POINTS], double c[4])
+    {
+        c[0] = y[0];
+        c[1] = 0.5 * (-11.0 * y[0] + 18.0 * y[1] - 9.0 * y[2] + 2.0 * y[3]);
+        c[2] = 4.5 * (2.0 * y[0] - 5.0 * y[1] + 4.0 * y[2] - y[3]);
+        c[3] = 4.5 * (-y[0] + 3.0 * y[1] - 3.0 * y[2] + y[3]);
+    }
+
+    inline double horner(const double c[4], double t)
+    {
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+}
+
+//------------------------------------------------------------------------------
+TabulatedAtmosphere::TabulatedAtmosphere(std::unique_ptr<Atmosphere> source, const TableOptions& options)
+    : source(std::move(source)), options(options)
+{
+    if (!this->source)
+        throw std::runtime_error("TabulatedAtmosphere needs a source model!");
+    // the table is a one-off snapshot; it would silently freeze the source's time
+    if (dynamic_cast<const TimeVaryingAtmosphere*>(this->source.get()))
+        throw std::runtime_error("TabulatedAtmosphere cannot tabulate a time-varying model!");
+    if (!(options.maxAltitude > options.minAltitude) || options.samples < 2)
+        throw std::runtime_error("Invalid TableOptions!");
+
+    std::size_t samples = options.samples;
+    build(samples);
+    measureError();
+
+    // Refine until the estimated error meets the target: 2n-1 nodes halve the
+    // spacing and keep all the old ones.
+    while (options.targetRelativeError > 0.0 && maxRelativeError() > options.targetRelativeError
+           && 2 * samples - 1 <= options.maxSamples)
+    {
+        samples = 2 * samples - 1;
+        build(samples);
+        measureError();
+    }
+
+    // sampling the source is not a user query
+    this->source->takeVacuumQueryCount();
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::coordinate(double altitude) const
+{
+    const double dh = altitude - options.minAltitude;
+    if (options.spacing == TableSpacing::Logarithmic)
+        return std::log1p(dh / logScale) * invStep;
+    return dh * invStep;
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::altitudeAt(double coord) const
+{
+    if (options.spacing == TableSpacing::Logarithmic)
+        return options.minAltitude + logScale * std::expm1(coord * step);
+    return options.minAltitude + coord * step;
+}
+
+//------------------------------------------------------------------------------
+void TabulatedAtmosphere::build(std::size_t samples)
+{
+    const std::size_t m = samples - 1; // intervals
+    const double range = options.maxAltitude - options.minAltitude;
+    step = (options.spacing == TableSpacing::Logarithmic) ? std::log1p(range / logScale) / m
+                                                          : range / m;
+    invStep = 1.0 / step;
+
+    // Every interval is fitted only from samples inside it (the last one just
+    // below the next node), so a kink or jump of the source that sits on a node
+    // does not leak into the neighbouring intervals.
+    std::vector<double> altitudes(FIT_POINTS * m);
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        const double lo = (i == 0) ? options.minAltitude : altitudeAt(static_cast<double>(i));
+        const double hi = (i + 1 == m) ? options.maxAltitude : altitudeAt(static_cast<double>(i + 1));
+        double* h = &altitudes[FIT_POINTS * i];
+        h[0] = lo;
+        h[1] = altitudeAt(static_cast<double>(i) + 1.0 / 3.0);
+        h[2] = altitudeAt(static_cast<double>(i) + 2.0 / 3.0);
+        h[3] = (i + 1 == m) ? hi : std::nextafter(hi, lo);
+    }
+
+    std::vector<double> T(altitudes.size()), P(altitudes.size()), rho(altitudes.size());
+    source->getPropertiesBatch(altitudes.data(), altitudes.size(), T.data(), P.data(), rho.data());
+
+    segments.assign(m, Segment());
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        fitCubic(&T[FIT_POINTS * i],   segments[i].T);
+        fitCubic(&P[FIT_POINTS * i],   segments[i].P);
+        fitCubic(&rho[FIT_POINTS * i], segments[i].rho);
+    }
+}
+
+//------------------------------------------------------------------------------
+void TabulatedAtmosphere::measureError()
+{
+    const std::size_t m = segments.size();
+    errorT = errorP = errorRho = 0.0;
+
+    std::vector<double> t, altitudes, T, P, rho;
+    std::vector<double> worstT(m), worstError(m, -1.0);
+
+    // Checks `perInterval` local coordinates of every interval (taken from t),
+    // folds them into the global maxima and tracks each interval's worst point.
+    auto check = [&](std::size_t perInterval)
+    {
+        altitudes.resize(m * perInterval);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t k = 0; k < perInterval; ++k)
+                altitudes[i * perInterval + k] = altitudeAt(static_cast<double>(i) + t[i * perInterval + k]);
+
+        T.resize(altitudes.size());
+        P.resize(altitudes.size());
+        rho.resize(altitudes.size());
+        source->getPropertiesBatch(altitudes.data(), altitudes.size(), T.data(), P.data(), rho.data());
+
+        for (std::size_t j = 0; j < altitudes.size(); ++j)
+        {
+            double ti, pi, ri;
+            interpolate(altitudes[j], ti, pi, ri);
+            const double eT = relativeError(ti, T[j]);
+            const double eP = relativeError(pi, P[j]);
+            const double eRho = relativeError(ri, rho[j]);
+            errorT = std::max(errorT, eT);
+            errorP = std::max(errorP, eP);
+            errorRho = std::max(errorRho, eRho);
+
+            const double e = std::max({eT, eP, eRho});
+            const std::size_t i = j / perInterval;
+            if (e > worstError[i])
+            {
+                worstError[i] = e;
+                worstT[i] = t[j];
+            }
+        }
+    };
+
+    // coarse pass
+    const std::size_t coarse = COARSE_CHECKS + 2;
+    t.resize(m * coarse);
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        double* ti = &t[i * coarse];
+        ti[0] = END_OFFSET;
+        for (std::size_t k = 0; k < COARSE_CHECKS; ++k)
+            ti[k + 1] = (k + 0.5) / COARSE_CHECKS;
+        ti[coarse - 1] = 1.0 - END_OFFSET;
+    }
+    check(coarse);
+
+    // zoom in on each interval's worst point
+    double spacing = 1.0 / COARSE_CHECKS;
+    t.resize(m * ZOOM_POINTS);
+    for (int round = 0; round < ZOOM_ROUNDS; ++round)
+    {
+        const double width = 2.0 * spacing / (ZOOM_POINTS - 1);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t k = 0; k < ZOOM_POINTS; ++k)
+                t[i * ZOOM_POINTS + k] = std::clamp(worstT[i] - spacing + k * width, 0.0, 1.0 - END_OFFSET);
+        check(ZOOM_POINTS);
+        spacing = width;
+    }
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::maxRelativeError() const
+{
+    return std::max({errorT, errorP, errorRho});
+}
+
+//------------------------------------------------------------------------------
+void TabulatedAtmosphere::interpolate(double altitude, double& T, double& P, double& rho) const
+{
+    // outside the table (or NaN): ask the source
+    if (!(altitude >= options.minAltitude && altitude <= options.maxAltitude))
+    {
+        source->getProperties(altitude, T, P, rho);
+        return;
+    }
+
+    const double u = coordinate(altitude);
+    std::size_t i = static_cast<std::size_t>(u);
+    i = std::min(i, segments.size() - 1);
+    const double t = u - static_cast<double>(i);
+
+    const Segment& s = segments[i];
+    T   = horner(s.T, t);
+    P   = horner(s.P, t);
+    rho = horner(s.rho, t);
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::getTemperature(double altitude) const
+{
+    double T, P, rho;
+    interpolate(altitude, T, P, rho);
+    return T;
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::getPressure(double altitude) const
+{
+    double T, P, rho;
+    interpolate(altitude, T, P, rho);
+    return P;
+}
+
+//------------------------------------------------------------------------------
+double TabulatedAtmosphere::getDensity(double altitude) const
+{
+    double T, P, rho;
+    interpolate(altitude, T, P, rho);
+    return rho;
+}
+
+//------------------------------------------------------------------------------
+void TabulatedAtmosphere::getProperties(double altitudeMeters,
+                                        double &temperature,
+                                        double &pressure,
+                                        double &density) const
+{
+    interpolate(altitudeMeters, temperature, pressure, density);
+}
+
+//------------------------------------------------------------------------------
+AtmosphereState TabulatedAtmosphere::getState(double altitudeMeters) const
+{
+    double T, P, rho;
+    interpolate(altitudeMeters, T, P, rho);
+    return air::makeState(T, P, rho);
+}
+
+//------------------------------------------------------------------------------
+void TabulatedAtmosphere::getPropertiesBatch(const double* altitudes,
+                                             std::size_t count,
+                                             double* temperature,
+                                             double* pressure,
+                                             double* density) const
+{
+    std::uint64_t spaceCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        interpolate(altitudes[i], temperature[i], pressure[i], density[i]);
+        spaceCount += (density[i] < VACUUM_DENSITY);
+    }
+    countVacuumQueries(spaceCount);
+}
@@ -0,0 +1,205 @@
+#include "US76_atmosphere.h"
+#include "ISA_tables.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // US Standard Atmosphere 1976 above 86 km (geometric altitude).
+    struct UpperNode
+    {
+        double hKm;   // altitude, km
+        double T;     // K
+        double P;     // Pa
+        double rho;   // kg/m^3
+    };
+
+    constexpr UpperNode UPPER_NODES[] = {
+            //  km,     T,        P,          rho
+            {   86.0,  186.87,  0.37338,    6.958e-6  },
+            {   90.0,  186.87,  0.18359,    3.416e-6  },
+            {   95.0,  188.42,  7.5966e-2,  1.393e-6  },
+            {  100.0,  195.08,  3.2011e-2,  5.604e-7  },
+            {  110.0,  240.00,  7.1042e-3,  9.708e-8  },
+            {  120.0,  360.00,  2.5382e-3,  2.222e-8  },
+            {  130.0,  469.27,  1.2505e-3,  8.152e-9  },
+            {  140.0,  559.63,  7.2028e-4,  3.831e-9  },
+            {  150.0,  634.39,  4.5422e-4,  2.076e-9  },
+            {  160.0,  696.29,  3.0395e-4,  1.233e-9  },
+            {  180.0,  790.07,  1.5271e-4,  5.194e-10 },
+            {  200.0,  854.56,  8.4736e-5,  2.541e-10 },
+            {  250.0,  941.33,  2.4767e-5,  6.073e-11 },
+            {  300.0,  976.01,  8.7704e-6,  1.916e-11 },
+            {  350.0,  990.06,  3.4498e-6,  7.014e-12 },
+            {  400.0,  995.83,  1.4518e-6,  2.803e-12 },
+            {  450.0,  998.22,  6.4468e-7,  1.184e-12 },
+            {  500.0,  999.24,  3.0236e-7,  5.215e-13 },
+            {  600.0,  999.85,  8.2140e-8,  1.137e-13 },
+            {  700.0,  999.97,  3.1188e-8,  3.070e-14 },
+            {  800.0,  999.99,  1.7036e-8,  1.136e-14 },
+            {  900.0, 1000.00,  1.0873e-8,  5.759e-15 },
+            { 1000.0, 1000.00,  7.5138e-9,  3.561e-15 },
+    };
+    constexpr int NUM_UPPER_NODES = sizeof(UPPER_NODES) / sizeof(UPPER_NODES[0]);
+    constexpr int NUM_SEGMENTS = NUM_UPPER_NODES - 1;
+
+    constexpr double TABLE_BOTTOM = 86000.0;   // m, below this the ISA layers apply
+    static_assert(UPPER_NODES[0].hKm * 1000.0 == TABLE_BOTTOM, "the table must start where the ISA layers end");
+
+    // O(1) segment lookup: every node sits on a whole km, so one entry per km
+    // between 86 and 1000 km gives the segment directly.
+    constexpr int SEGMENT_BUCKETS = static_cast<int>(UPPER_NODES[NUM_UPPER_NODES - 1].hKm - UPPER_NODES[0].hKm);
+
+    constexpr bool nodesOnWholeKmAndIncreasing()
+    {
+        for (int i = 0; i < NUM_UPPER_NODES; ++i)
+        {
+            if (static_cast<double>(static_cast<long>(UPPER_NODES[i].hKm)) != UPPER_NODES[i].hKm)
+                return false;
+            if (i > 0 && !(UPPER_NODES[i].hKm > UPPER_NODES[i - 1].hKm))
+                return false;
+        }
+        return true;
+    }
+    static_assert(nodesOnWholeKmAndIncreasing(), "US76 nodes must be increasing whole km");
+
+    struct SegmentBuckets
+    {
+        unsigned char segment[SEGMENT_BUCKETS];
+    };
+
+    constexpr SegmentBuckets makeSegmentBuckets()
+    {
+        SegmentBuckets buckets{};
+        for (int km = 0; km < SEGMENT_BUCKETS; ++km)
+        {
+            const double h = UPPER_NODES[0].hKm + km;
+            int segment = 0;
+            while (segment + 1 < NUM_SEGMENTS && h >= UPPER_NODES[segment + 1].hKm)
+                ++segment;
+            buckets.segment[km] = static_cast<unsigned char>(segment);
+        }
+        return buckets;
+    }
+    constexpr SegmentBuckets SEGMENT_OF_KM = makeSegmentBuckets();
+
+    // Segment for an altitude at or above TABLE_BOTTOM (above the table top it
+    // stays on the last segment, which is then extrapolated).
+    inline int segmentIndex(double altitudeMeters)
+    {
+        const double km = (altitudeMeters - TABLE_BOTTOM) * 1.0e-3;
+        const int bucket = km > 0.0 ? static_cast<int>(std::min(km, SEGMENT_BUCKETS - 1.0)) : 0;
+        return SEGMENT_OF_KM.segment[bucket];
+    }
+}
+
+//------------------------------------------------------------------------------
+US76_atmosphere::US76_atmosphere()
+{
+    // per-segment linear temperature and log-linear pressure/density slopes
+    segments.reserve(NUM_SEGMENTS);
+    for (int i = 0; i < NUM_SEGMENTS; ++i)
+    {
+        const UpperNode& lo = UPPER_NODES[i];
+        const UpperNode& hi = UPPER_NODES[i + 1];
+        const double dh = (hi.hKm - lo.hKm) * 1000.0;
+
+        Segment segment;
+        segment.hBase     = lo.hKm * 1000.0;
+        segment.tBase     = lo.T;
+        segment.lapseRate = (hi.T - lo.T) / dh;
+        segment.pBase     = lo.P;
+        segment.pSlope    = std::log(hi.P / lo.P) / dh;
+        segment.rhoBase   = lo.rho;
+        segment.rhoSlope  = std::log(hi.rho / lo.rho) / dh;
+        segments.push_back(segment);
+    }
+}
+
+//------------------------------------------------------------------------------
+void US76_atmosphere::evaluate(double altitudeMeters,
+                               double &temperature,
+                               double &pressure,
+                               double &density) const
+{
+    // 1) below 86 km the standard ISA layers
+    if (!(altitudeMeters >= TABLE_BOTTOM))
+    {
+        isa::evaluate(altitudeMeters, temperature, pressure, density);
+        return;
+    }
+
+    // 2) thermosphere table: T linear, P and rho exponential within the segment
+    const Segment& s = segments[segmentIndex(altitudeMeters)];
+    const double dh = altitudeMeters - s.hBase;
+    temperature = s.tBase + s.lapseRate * dh;
+    pressure    = s.pBase * std::exp(s.pSlope * dh);
+    density     = s.rhoBase * std::exp(s.rhoSlope * dh);
+}
+
+//------------------------------------------------------------------------------
+double US76_atmosphere::getTemperature(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return T;
+}
+
+//------------------------------------------------------------------------------
+double US76_atmosphere::getPressure(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return P;
+}
+
+//------------------------------------------------------------------------------
+double US76_atmosphere::getDensity(double altitude) const
+{
+    double T, P, rho;
+    getProperties(altitude, T, P, rho);
+    return rho;
+}
+
+//------------------------------------------------------------------------------
+void US76_atmosphere::getProperties(double altitudeMeters,
+                                    double &temperature,
+                                    double &pressure,
+                                    double &density) const
+{
+    evaluate(altitudeMeters, temperature, pressure, density);
+}
+
+//------------------------------------------------------------------------------
+AtmosphereState US76_atmosphere::getState(double altitudeMeters) const
+{
+    double T, P, rho;
+    getProperties(altitudeMeters, T, P, rho);
+    return air::makeState(T, P, rho);
+}
+
+//------------------------------------------------------------------------------
+void US76_atmosphere::getPropertiesBatch(const double* altitudes,
+                                         std::size_t count,
+                                         double* temperature,
+                                         double* pressure,
+                                         double* density) const
+{
+    evaluateBatch(altitudes, count, temperature, pressure, density);
+
+    std::uint64_t spaceCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        spaceCount += (density[i] < VACUUM_DENSITY);
+    countVacuumQueries(spaceCount);
+}
+
+//------------------------------------------------------------------------------
+void US76_atmosphere::evaluateBatch(const double* altitudes,
+                                    std::size_t count,
+                                    double* temperature,
+                                    double* pressure,
+                                    double* density) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+        evaluate(altitudes[i], temperature[i], pressure[i], density[i]);
+}
@@ -0,0 +1,215 @@
+#include "BarnesHutSolver.h"
+#include "ParticleSystem.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Cells smaller than this stop splitting; bodies that (nearly) coincide are
+    // then lumped together in one leaf instead of recursing forever.
+    constexpr float MIN_HALF_SIZE = 1.0e-4f;
+
+    // Depth of the traversal stack. Every pop pushes at most 4 children and the
+    // tree depth is bounded by MIN_HALF_SIZE, so this is never reached in practice.
+    constexpr int MAX_STACK = 512;
+
+    // Node::body markers
+    constexpr int EMPTY  = -1;
+    constexpr int LUMPED = -2;
+}
+
+//------------------------------------------------------------------------------
+BarnesHutSolver::BarnesHutSolver(float theta)
+    : theta(theta)
+{
+}
+
+//------------------------------------------------------------------------------
+void BarnesHutSolver::computeAccelerations(const ParticleSystem& particles,
+                                           float* ax,
+                                           float* ay)
+{
+    const std::size_t n = particles.size();
+    if (n == 0) return;
+
+    // the tree is built serially, then every body walks it independently
+    buildTree(particles);
+
+    parallelFor(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            accelerationOn(particles, static_cast<int>(i), ax[i], ay[i]);
+    });
+}
+
+//------------------------------------------------------------------------------
+void BarnesHutSolver::buildTree(const ParticleSystem& particles)
+{
+    const std::size_t n = particles.size();
+
+    // 1) Square bounding box around every body
+    float minX = particles.x[0], maxX = particles.x[0];
+    float minY = particles.y[0], maxY = particles.y[0];
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        minX = std::min(minX, particles.x[i]);
+        maxX = std::max(maxX, particles.x[i]);
+        minY = std::min(minY, particles.y[i]);
+        maxY = std::max(maxY, particles.y[i]);
+    }
+    float halfSize = 0.5f * std::max(maxX - minX, maxY - minY);
+    halfSize = std::max(halfSize * 1.0001f, MIN_HALF_SIZE); // keep bodies on the edge inside
+
+    // 2) Reset the node pool (capacity is kept from the previous step)
+    nodes.clear();
+    nodes.push_back(Node{0.5f * (minX + maxX), 0.5f * (minY + maxY), halfSize,
+                         0.0f, 0.0f, 0.0f, -1, EMPTY});
+
+    // 3) Insert bodies; every node on the way accumulates mass and mass*position
+    for (std::size_t i = 0; i < n; ++i)
+        insertBody(particles, static_cast<int>(i));
+
+    // 4) Turn the weighted sums into centres of mass
+    for (auto& node : nodes)
+    {
+        if (node.mass > 0.0f)
+        {
+            node.comX /= node.mass;
+            node.comY /= node.mass;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int BarnesHutSolver::childFor(const Node& node, float px, float py) const
+{
+    // children are stored as: 0 = south-west, 1 = south-east, 2 = north-west, 3 = north-east
+    int quadrant = 0;
+    if (px >= node.cx) quadrant += 1;
+    if (py >= node.cy) quadrant += 2;
+    return node.firstChild + quadrant;
+}
+
+//------------------------------------------------------------------------------
+void BarnesHutSolver::subdivide(int nodeIndex)
+{
+    const int first = static_cast<int>(nodes.size());
+    const Node parent = nodes[nodeIndex]; // copy: push_back may reallocate
+    const float h = 0.5f * parent.halfSize;
+
+    nodes.push_back(Node{parent.cx - h, parent.cy - h, h, 0.0f, 0.0f, 0.0f, -1, EMPTY});
+    nodes.push_back(Node{parent.cx + h, parent.cy - h, h, 0.0f, 0.0f, 0.0f, -1, EMPTY});
+    nodes.push_back(Node{parent.cx - h, parent.cy + h, h, 0.0f, 0.0f, 0.0f, -1, EMPTY});
+    nodes.push_back(Node{parent.cx + h, parent.cy + h, h, 0.0f, 0.0f, 0.0f, -1, EMPTY});
+
+    nodes[nodeIndex].firstChild = first;
+}
+
+//------------------------------------------------------------------------------
+void BarnesHutSolver::insertBody(const ParticleSystem& particles, int body)
+{
+    const float px = particles.x[body];
+    const float py = particles.y[body];
+    const float m  = particles.mass[body];
+
+    int current = 0;
+    while (true)
+    {
+        Node& node = nodes[current];
+        node.mass += m;
+        node.comX += m * px;
+        node.comY += m * py;
+
+        if (node.firstChild >= 0)
+        {
+            // internal node: keep descending
+            current = childFor(node, px, py);
+            continue;
+        }
+
+        if (node.body == EMPTY)
+        {
+            // empty leaf: the body lives here now
+            node.body = body;
+            return;
+        }
+
+        if (node.halfSize < MIN_HALF_SIZE)
+        {
+            // too small to split: the leaf keeps the lumped mass of every body in it
+            node.body = LUMPED;
+            return;
+        }
+
+        // occupied leaf: split it and push the resident body one level down
+        const int resident = node.body;
+        subdivide(current);
+        Node& parent = nodes[current];
+        parent.body = EMPTY;
+
+        if (resident >= 0)
+        {
+            const float rx = particles.x[resident];
+            const float ry = particles.y[resident];
+            const float rm = particles.mass[resident];
+            Node& child = nodes[childFor(parent, rx, ry)];
+            child.mass = rm;
+            child.comX = rm * rx;
+            child.comY = rm * ry;
+            child.body = resident;
+        }
+
+        current = childFor(parent, px, py);
+    }
+}
+
+//------------------------------------------------------------------------------
+void BarnesHutSolver::accelerationOn(const ParticleSystem& particles, int body,
+                                     float& ax, float& ay) const
+{
+    const float px = particles.x[body];
+    const float py = particles.y[body];
+    const float g = static_cast<float>(constants::GRAV_CONST_SCALED);
+    const float theta2 = theta * theta;
+
+    Vec2 acc;
+
+    int stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if (node.mass <= 0.0f || node.body == body) continue;
+
+        const Vec2 d{node.comX - px, node.comY - py};
+        const float r2 = d.lengthSquared();
+
+        // Open the cell if it is too wide for the distance, (2*halfSize)^2 >= theta^2 * r^2,
+        // or if the body itself sits inside it (its own mass must not be lumped in).
+        const float width = 2.0f * node.halfSize;
+        const bool containsBody = std::abs(px - node.cx) <= node.halfSize
+                               && std::abs(py - node.cy) <= node.halfSize;
+        if (node.firstChild >= 0 && (containsBody || width * width >= theta2 * r2)
+            && top + 4 <= MAX_STACK)
+        {
+            stack[top++] = node.firstChild;
+            stack[top++] = node.firstChild + 1;
+            stack[top++] = node.firstChild + 2;
+            stack[top++] = node.firstChild + 3;
+            continue;
+        }
+
+        if (r2 <= 0.0f) continue; // lumped leaf sitting exactly on the body
+
+        float invR = 1.0f / std::sqrt(r2);
+        acc += d * (g * node.mass * invR * invR * invR);
+    }
+
+    ax = acc.x;
+    ay = acc.y;
+}
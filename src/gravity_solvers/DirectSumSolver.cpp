@@ -0,0 +1,39 @@
+#include "DirectSumSolver.h"
+#include "ParticleSystem.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
+#include "constants.h"
+#include <cmath>
+
+void DirectSumSolver::computeAccelerations(const ParticleSystem& particles,
+                                           float* ax,
+                                           float* ay)
+{
+    const std::size_t n = particles.size();
+    const float* x = particles.x.data();
+    const float* y = particles.y.data();
+    const float* mass = particles.mass.data();
+    const float g = static_cast<float>(constants::GRAV_CONST_SCALED);
+
+    parallelFor(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const Vec2 p{x[i], y[i]};
+            Vec2 acc;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                if (j == i) continue;
+                const Vec2 d = Vec2{x[j], y[j]} - p;
+                float r2 = d.lengthSquared();
+                if (r2 <= 0.0f) continue;   // coincident bodies exert no defined force
+
+                // a = G*m_j / (r*scale)^2 along the unit vector d/r
+                float invR = 1.0f / std::sqrt(r2);
+                acc += d * (g * mass[j] * invR * invR * invR);
+            }
+            ax[i] = acc.x;
+            ay[i] = acc.y;
+        }
+    });
+}
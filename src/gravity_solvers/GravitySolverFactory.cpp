@@ -0,0 +1,23 @@
+#include "GravitySolverFactory.h"
+#include "DirectSumSolver.h"
+#include "SymmetricDirectSumSolver.h"
+#include "SimdDirectSumSolver.h"
+#include "BarnesHutSolver.h"
+#include <stdexcept>
+
+std::unique_ptr<GravitySolver> GravitySolverFactory::createSolver(GravitySolverType type)
+{
+    switch (type) {
+        case GravitySolverType::DirectSum:
+            return std::make_unique<DirectSumSolver>();
+        case GravitySolverType::SymmetricDirectSum:
+            return std::make_unique<SymmetricDirectSumSolver>();
+        case GravitySolverType::SimdDirectSum:
+            return std::make_unique<SimdDirectSumSolver>();
+        case GravitySolverType::BarnesHut:
+            return std::make_unique<BarnesHutSolver>();
+        default:
+            throw std::runtime_error("Unknown GravitySolverType!");
+
+    }
+}
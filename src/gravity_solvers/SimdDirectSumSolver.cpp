@@ -0,0 +1,211 @@
+#include "SimdDirectSumSolver.h"
+#include "ParticleSystem.h"
+#include "ThreadPool.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GRAVITY_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    struct Sources
+    {
+        const float* x;
+        const float* y;
+        const float* gm;
+        std::size_t n;
+    };
+
+    // Scalar tail / fallback: pull of sources [begin, n) on the point (px, py).
+    inline void accumulateScalar(const Sources& s, std::size_t begin, float px, float py,
+                                 float& sumX, float& sumY)
+    {
+        for (std::size_t j = begin; j < s.n; ++j)
+        {
+            float dx = s.x[j] - px;
+            float dy = s.y[j] - py;
+            float r2 = dx*dx + dy*dy;
+            // r2 == 0 is the body itself (or a coincident one): no force
+            float invR = r2 > 0.0f ? 1.0f / std::sqrt(r2) : 0.0f;
+            float k = s.gm[j] * invR * invR * invR;
+            sumX += k * dx;
+            sumY += k * dy;
+        }
+    }
+
+    void targetsScalar(const Sources& s, const float* x, const float* y,
+                       std::size_t begin, std::size_t end, float* ax, float* ay)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float sumX = 0.0f, sumY = 0.0f;
+            accumulateScalar(s, 0, x[i], y[i], sumX, sumY);
+            ax[i] = sumX;
+            ay[i] = sumY;
+        }
+    }
+
+#ifdef GRAVITY_SIMD_X86
+    __attribute__((target("avx2,fma")))
+    inline float horizontalSum8(__m256 v)
+    {
+        __m128 lo = _mm256_castps256_ps128(v);
+        __m128 hi = _mm256_extractf128_ps(v, 1);
+        lo = _mm_add_ps(lo, hi);
+        lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+        lo = _mm_add_ss(lo, _mm_movehdup_ps(lo));
+        return _mm_cvtss_f32(lo);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void targetsAvx2(const Sources& s, const float* x, const float* y,
+                     std::size_t begin, std::size_t end, float* ax, float* ay)
+    {
+        const std::size_t vecEnd = s.n - s.n % 8;
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 threeHalves = _mm256_set1_ps(1.5f);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const __m256 px = _mm256_set1_ps(x[i]);
+            const __m256 py = _mm256_set1_ps(y[i]);
+            __m256 sumX = zero;
+            __m256 sumY = zero;
+
+            for (std::size_t j = 0; j < vecEnd; j += 8)
+            {
+                __m256 dx = _mm256_sub_ps(_mm256_load_ps(s.x + j), px);
+                __m256 dy = _mm256_sub_ps(_mm256_load_ps(s.y + j), py);
+                __m256 r2 = _mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy));
+
+                // 1/sqrt(r2): 12-bit estimate refined by one Newton step
+                __m256 inv = _mm256_rsqrt_ps(r2);
+                __m256 t = _mm256_mul_ps(_mm256_mul_ps(half, r2), _mm256_mul_ps(inv, inv));
+                inv = _mm256_mul_ps(inv, _mm256_sub_ps(threeHalves, t));
+
+                __m256 k = _mm256_mul_ps(_mm256_load_ps(s.gm + j),
+                                         _mm256_mul_ps(inv, _mm256_mul_ps(inv, inv)));
+                // drop r2 == 0 lanes (self-interaction gives inf * 0 = NaN otherwise)
+                k = _mm256_and_ps(k, _mm256_cmp_ps(r2, zero, _CMP_GT_OQ));
+
+                sumX = _mm256_fmadd_ps(k, dx, sumX);
+                sumY = _mm256_fmadd_ps(k, dy, sumY);
+            }
+
+            float tailX = 0.0f, tailY = 0.0f;
+            accumulateScalar(s, vecEnd, x[i], y[i], tailX, tailY);
+            ax[i] = horizontalSum8(sumX) + tailX;
+            ay[i] = horizontalSum8(sumY) + tailY;
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void targetsAvx512(const Sources& s, const float* x, const float* y,
+                       std::size_t begin, std::size_t end, float* ax, float* ay)
+    {
+        const std::size_t vecEnd = s.n - s.n % 16;
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512 half = _mm512_set1_ps(0.5f);
+        const __m512 threeHalves = _mm512_set1_ps(1.5f);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const __m512 px = _mm512_set1_ps(x[i]);
+            const __m512 py = _mm512_set1_ps(y[i]);
+            __m512 sumX = zero;
+            __m512 sumY = zero;
+
+            for (std::size_t j = 0; j < vecEnd; j += 16)
+            {
+                __m512 dx = _mm512_sub_ps(_mm512_load_ps(s.x + j), px);
+                __m512 dy = _mm512_sub_ps(_mm512_load_ps(s.y + j), py);
+                __m512 r2 = _mm512_fmadd_ps(dx, dx, _mm512_mul_ps(dy, dy));
+
+                // 1/sqrt(r2): 14-bit estimate refined by one Newton step
+                __m512 inv = _mm512_rsqrt14_ps(r2);
+                __m512 t = _mm512_mul_ps(_mm512_mul_ps(half, r2), _mm512_mul_ps(inv, inv));
+                inv = _mm512_mul_ps(inv, _mm512_sub_ps(threeHalves, t));
+
+                __m512 k = _mm512_mul_ps(_mm512_load_ps(s.gm + j),
+                                         _mm512_mul_ps(inv, _mm512_mul_ps(inv, inv)));
+                // drop r2 == 0 lanes (self-interaction)
+                __mmask16 valid = _mm512_cmp_ps_mask(r2, zero, _CMP_GT_OQ);
+                k = _mm512_maskz_mov_ps(valid, k);
+
+                sumX = _mm512_fmadd_ps(k, dx, sumX);
+                sumY = _mm512_fmadd_ps(k, dy, sumY);
+            }
+
+            float tailX = 0.0f, tailY = 0.0f;
+            accumulateScalar(s, vecEnd, x[i], y[i], tailX, tailY);
+            ax[i] = _mm512_reduce_add_ps(sumX) + tailX;
+            ay[i] = _mm512_reduce_add_ps(sumY) + tailY;
+        }
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+SimdDirectSumSolver::SimdDirectSumSolver()
+    : isa(detectIsa())
+{
+}
+
+//------------------------------------------------------------------------------
+SimdDirectSumSolver::SimdDirectSumSolver(Isa maxIsa)
+    : isa(std::min(maxIsa, detectIsa()))
+{
+}
+
+//------------------------------------------------------------------------------
+SimdDirectSumSolver::Isa SimdDirectSumSolver::detectIsa()
+{
+#ifdef GRAVITY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return Isa::AVX2;
+#endif
+    return Isa::Scalar;
+}
+
+//------------------------------------------------------------------------------
+void SimdDirectSumSolver::computeAccelerations(const ParticleSystem& particles,
+                                               float* ax,
+                                               float* ay)
+{
+    const std::size_t n = particles.size();
+    const float g = static_cast<float>(constants::GRAV_CONST_SCALED);
+
+    gm.resize(n);
+    for (std::size_t j = 0; j < n; ++j)
+        gm[j] = g * particles.mass[j];
+
+    const Sources sources{particles.x.data(), particles.y.data(), gm.data(), n};
+    const float* x = particles.x.data();
+    const float* y = particles.y.data();
+
+    parallelFor(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        switch (isa)
+        {
+#ifdef GRAVITY_SIMD_X86
+            case Isa::AVX512:
+                targetsAvx512(sources, x, y, begin, end, ax, ay);
+                break;
+            case Isa::AVX2:
+                targetsAvx2(sources, x, y, begin, end, ax, ay);
+                break;
+#endif
+            default:
+                targetsScalar(sources, x, y, begin, end, ax, ay);
+                break;
+        }
+    });
+}
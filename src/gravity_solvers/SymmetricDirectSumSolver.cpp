@@ -0,0 +1,121 @@
+#include "SymmetricDirectSumSolver.h"
+#include "ParticleSystem.h"
+#include "ThreadPool.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    struct Bodies
+    {
+        const float* x;
+        const float* y;
+        const float* mass;
+        float* ax;
+        float* ay;
+        std::size_t n;
+        float g;
+    };
+
+    // Pair interaction: adds the pull of j to i and the opposite pull of i to j.
+    inline void interact(const Bodies& b, std::size_t i, std::size_t j, float& sumX, float& sumY)
+    {
+        float dx = b.x[j] - b.x[i];
+        float dy = b.y[j] - b.y[i];
+        float r2 = dx*dx + dy*dy;
+        if (r2 <= 0.0f) return;   // coincident bodies exert no defined force
+
+        float invR = 1.0f / std::sqrt(r2);
+        float k = b.g * invR * invR * invR;   // shared by both directions
+        float si = k * b.mass[j];
+        float sj = k * b.mass[i];
+        sumX += si * dx;
+        sumY += si * dy;
+        b.ax[j] -= sj * dx;
+        b.ay[j] -= sj * dy;
+    }
+
+    // All pairs inside one tile.
+    void diagonalTile(const Bodies& b, std::size_t tile)
+    {
+        const std::size_t begin = tile * SymmetricDirectSumSolver::TILE_SIZE;
+        const std::size_t end = std::min(begin + SymmetricDirectSumSolver::TILE_SIZE, b.n);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float sumX = 0.0f, sumY = 0.0f;
+            for (std::size_t j = i + 1; j < end; ++j)
+                interact(b, i, j, sumX, sumY);
+            b.ax[i] += sumX;
+            b.ay[i] += sumY;
+        }
+    }
+
+    // All pairs between two different tiles.
+    void offDiagonalTile(const Bodies& b, std::size_t tileI, std::size_t tileJ)
+    {
+        const std::size_t iBegin = tileI * SymmetricDirectSumSolver::TILE_SIZE;
+        const std::size_t iEnd = std::min(iBegin + SymmetricDirectSumSolver::TILE_SIZE, b.n);
+        const std::size_t jBegin = tileJ * SymmetricDirectSumSolver::TILE_SIZE;
+        const std::size_t jEnd = std::min(jBegin + SymmetricDirectSumSolver::TILE_SIZE, b.n);
+        for (std::size_t i = iBegin; i < iEnd; ++i)
+        {
+            float sumX = 0.0f, sumY = 0.0f;
+            for (std::size_t j = jBegin; j < jEnd; ++j)
+                interact(b, i, j, sumX, sumY);
+            b.ax[i] += sumX;
+            b.ay[i] += sumY;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void SymmetricDirectSumSolver::computeAccelerations(const ParticleSystem& particles,
+                                                    float* ax,
+                                                    float* ay)
+{
+    const std::size_t n = particles.size();
+    std::fill(ax, ax + n, 0.0f);
+    std::fill(ay, ay + n, 0.0f);
+    if (n < 2) return;
+
+    const Bodies b{particles.x.data(), particles.y.data(), particles.mass.data(),
+                   ax, ay, n, static_cast<float>(constants::GRAV_CONST_SCALED)};
+    const std::size_t tiles = (n + TILE_SIZE - 1) / TILE_SIZE;
+
+    // Colour 0: the diagonal tiles are independent of each other.
+    parallelFor(pool, tiles, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t t = begin; t < end; ++t)
+            diagonalTile(b, t);
+    });
+
+    // Remaining colours: round-robin ("circle method") schedule over an even
+    // number of slots. Every round pairs each tile with exactly one other, so
+    // the tile pairs of a round write disjoint bodies. Slot `tiles` is a dummy
+    // when the tile count is odd.
+    const std::size_t slots = tiles + (tiles % 2);
+    const std::size_t ring = slots - 1;
+    for (std::size_t round = 0; round < ring; ++round)
+    {
+        parallelFor(pool, slots / 2, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                std::size_t first, second;
+                if (k == 0)
+                {
+                    first = round;
+                    second = ring;
+                }
+                else
+                {
+                    first = (round + k) % ring;
+                    second = (round + ring - k) % ring;
+                }
+                if (first >= tiles || second >= tiles) continue;
+                offDiagonalTile(b, std::min(first, second), std::max(first, second));
+            }
+        });
+    }
+}
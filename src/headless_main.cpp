@@ -0,0 +1,316 @@
+// Headless front end: runs the physics core for a fixed number of steps as fast
+// as the machine allows (no window, no vsync) and writes the bodies to disk.
+// Optionally renders frames on the CPU (same picture as the viewer) as
+// numbered PPM images or one raw RGBA video stream.
+//
+// usage: gravity_headless [--steps N] [--dt DT] [--bodies N] [--seed S]
+//                         [--solver direct|symmetric|simd|barneshut] [--theta T]
+//                         [--integrator euler|leapfrog|verlet|yoshida4]
+//                         [--threads N] [--output FILE] [--every K]
+//                         [--frames PREFIX] [--video FILE] [--frame-every K]
+//                         [--width W] [--height H] [--trails N]
+//                         [--drag none|isa|static-isa|tabulated|us76|spaceweather]
+//                         [--space-weather FILE]
+//
+// --frames writes PREFIX_000000.ppm, PREFIX_000001.ppm, ...; --video writes
+// the frames back to back as RGBA, e.g. for
+//   ffmpeg -f rawvideo -pix_fmt rgba -s 1400x1000 -r 60 -i FILE out.mp4
+// --trails N draws each body's last N trail points (sampled every step).
+// --drag adds atmospheric drag around body 0 with the given model;
+// --space-weather feeds the spaceweather model from a CSV of F10.7 / Ap
+// indices (see SpaceWeather.h), otherwise it uses constant moderate activity.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "AtmosphereFactory.h"
+#include "BarnesHutSolver.h"
+#include "DrawList.h"
+#include "GravitySolverFactory.h"
+#include "IntegratorFactory.h"
+#include "Scenarios.h"
+#include "Simulation.h"
+#include "SoftwareRasterizer.h"
+#include "StaticDrag.h"
+#include "ThreadPool.h"
+#include "TrailBuffer.h"
+#include "constants.h"
+
+
+struct HeadlessOptions
+{
+    long long steps = 1000;
+    float dt = 1.0f;
+    std::size_t bodies = 0;          // 0 = the Earth-Moon pair
+    unsigned seed = 1;
+    GravitySolverType solver = GravitySolverType::SimdDirectSum;
+    float theta = 0.5f;
+    IntegratorType integrator = IntegratorType::VelocityVerlet;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string output = "simulation.csv";
+    long long every = 100;           // write a snapshot every K steps (0 = only the last)
+
+    std::string framePrefix;         // numbered PPM frames (empty = none)
+    std::string video;               // raw RGBA stream (empty = none)
+    long long frameEvery = 1;        // render every K steps
+    int width = static_cast<int>(constants::screenWidth);
+    int height = static_cast<int>(constants::screenHeight);
+    std::size_t trails = 0;          // trail points per body (0 = no trails)
+
+    bool drag = false;               // atmospheric drag around body 0
+    bool staticDrag = false;         // through StaticIsaDrag instead of the factory model
+    AtmosphereType atmosphere = AtmosphereType::ISA;
+    std::string spaceWeather;        // CSV of indices for AtmosphereType::SpaceWeather
+
+    bool rendering() const { return !framePrefix.empty() || !video.empty(); }
+};
+
+// Draws the bodies on the CPU and writes the frames out.
+class FrameOutput {
+public:
+    FrameOutput(const HeadlessOptions& options, ThreadPool* pool);
+    bool ok() const { return options.video.empty() || video.is_open(); }
+    void record(const Simulation& simulation);
+    bool write(const Simulation& simulation);
+    long long count() const { return frames; }
+
+private:
+    const HeadlessOptions& options;
+    DrawList drawList;
+    SoftwareRasterizer rasterizer;
+    std::unique_ptr<TrailBuffer> trails;
+    ThreadPool* pool;
+    std::ofstream video;
+    long long frames = 0;
+};
+
+bool parseArguments(int argc, char** argv, HeadlessOptions& options);
+void writeSnapshot(std::ostream& out, const Simulation& simulation, long long step);
+
+
+
+int main(int argc, char** argv) {
+
+    HeadlessOptions options;
+    if (!parseArguments(argc, argv, options))
+        return 1;
+
+    ThreadPool pool(options.threads);
+    auto gravity = GravitySolverFactory::createSolver(options.solver);
+    if (auto* tree = dynamic_cast<BarnesHutSolver*>(gravity.get()))
+        tree->setTheta(options.theta);
+
+    Simulation simulation(std::move(gravity), &pool,
+                          IntegratorFactory::createIntegrator(options.integrator));
+
+    if (options.drag)
+    {
+        try {
+            std::unique_ptr<AtmosphericDrag> drag;
+            if (options.staticDrag)
+                drag = std::make_unique<StaticIsaDrag>(0);
+            else
+                drag = std::make_unique<AtmosphericDrag>(
+                        AtmosphereFactory::createAtmosphere(options.atmosphere, options.spaceWeather), 0);
+            simulation.setDrag(std::move(drag));
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.bodies == 0)
+        scenarios::addEarthMoon(simulation.particles());
+    else
+        scenarios::addOrbitingDisk(simulation.particles(), options.bodies, options.seed);
+
+    std::ofstream out(options.output);
+    if (!out) {
+        std::cerr << "cannot open output file " << options.output << std::endl;
+        return 1;
+    }
+    out.precision(std::numeric_limits<float>::max_digits10); // round-trips the float state
+    out << "step,time,body,x,y,vx,vy\n";
+    writeSnapshot(out, simulation, 0);
+
+    std::unique_ptr<FrameOutput> frames;
+    if (options.rendering())
+    {
+        frames = std::make_unique<FrameOutput>(options, &pool);
+        frames->record(simulation);
+        if (!frames->ok() || !frames->write(simulation)) {
+            std::cerr << "cannot write frames" << std::endl;
+            return 1;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (long long step = 1; step <= options.steps; ++step)
+    {
+        simulation.step(options.dt);
+
+        if ((options.every > 0 && step % options.every == 0) || step == options.steps)
+            writeSnapshot(out, simulation, step);
+
+        if (frames)
+            frames->record(simulation);
+        if (frames && (step % options.frameEvery == 0 || step == options.steps) && !frames->write(simulation)) {
+            std::cerr << "cannot write frames" << std::endl;
+            return 1;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << options.steps << " steps of " << simulation.particles().size()
+              << " bodies on " << pool.size() << " threads in " << seconds << " s ("
+              << (seconds > 0.0 ? options.steps / seconds : 0.0) << " steps/s), wrote "
+              << options.output;
+    if (frames)
+        std::cout << " and " << frames->count() << " frames";
+    std::cout << std::endl;
+
+    if (const AtmosphericDrag* drag = simulation.drag())
+        if (const std::uint64_t vacuum = drag->atmosphere().takeVacuumQueryCount())
+            std::cerr << "[atmosphere] " << vacuum << " queries above the atmosphere "
+                      << "(density < 1e-6 of sea level)" << std::endl;
+    return 0;
+}
+
+
+
+//_______________________________________ FUNCTION DEFINITIONS____________________________________________-
+
+
+
+void writeSnapshot(std::ostream& out, const Simulation& simulation, long long step)
+{
+    const ParticleSystem& p = simulation.particles();
+    for (std::size_t i = 0; i < p.size(); ++i)
+    {
+        out << step << ',' << simulation.time() << ',' << i << ','
+            << p.x[i] << ',' << p.y[i] << ',' << p.vx[i] << ',' << p.vy[i] << '\n';
+    }
+}
+
+
+FrameOutput::FrameOutput(const HeadlessOptions& options, ThreadPool* pool)
+    : options(options), rasterizer(options.width, options.height, pool), pool(pool)
+{
+    if (options.trails > 0)
+        trails = std::make_unique<TrailBuffer>(std::max<std::size_t>(options.trails, 2));
+    // the viewer's window, stretched onto the requested frame size
+    drawList.setView(ViewTransform(constants::screenWidth, constants::screenHeight));
+    if (!options.video.empty())
+        video.open(options.video, std::ios::binary);
+}
+
+
+void FrameOutput::record(const Simulation& simulation)
+{
+    const ParticleSystem& bodies = simulation.particles();
+    if (trails)
+        trails->record(bodies.x.data(), bodies.y.data(), bodies.size(), pool);
+}
+
+
+bool FrameOutput::write(const Simulation& simulation)
+{
+    drawList.clear();
+    if (trails)
+        trails->addTo(drawList, packColor(90, 110, 160));
+    drawList.addBodies(simulation.particles());
+    rasterizer.draw(drawList);
+
+    if (video.is_open())
+        writeRawRgba(video, rasterizer.framebuffer());
+    if (!options.framePrefix.empty())
+    {
+        char number[16];
+        std::snprintf(number, sizeof(number), "_%06lld.ppm", frames);
+        std::ofstream image(options.framePrefix + number, std::ios::binary);
+        writePpm(image, rasterizer.framebuffer());
+        if (!image)
+            return false;
+    }
+    ++frames;
+    return !video.is_open() || static_cast<bool>(video);
+}
+
+
+bool parseArguments(int argc, char** argv, HeadlessOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--steps")           options.steps = std::atoll(value.c_str());
+        else if (arg == "--dt")         options.dt = std::strtof(value.c_str(), nullptr);
+        else if (arg == "--bodies")     options.bodies = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--seed")       options.seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--theta")      options.theta = std::strtof(value.c_str(), nullptr);
+        else if (arg == "--threads")    options.threads = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--output")     options.output = value;
+        else if (arg == "--every")      options.every = std::atoll(value.c_str());
+        else if (arg == "--frames")     options.framePrefix = value;
+        else if (arg == "--video")      options.video = value;
+        else if (arg == "--frame-every") options.frameEvery = std::atoll(value.c_str());
+        else if (arg == "--width")      options.width = std::atoi(value.c_str());
+        else if (arg == "--height")     options.height = std::atoi(value.c_str());
+        else if (arg == "--trails")     options.trails = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--space-weather") options.spaceWeather = value;
+        else if (arg == "--solver")
+        {
+            if (value == "direct")          options.solver = GravitySolverType::DirectSum;
+            else if (value == "symmetric")  options.solver = GravitySolverType::SymmetricDirectSum;
+            else if (value == "simd")       options.solver = GravitySolverType::SimdDirectSum;
+            else if (value == "barneshut")  options.solver = GravitySolverType::BarnesHut;
+            else { std::cerr << "unknown solver " << value << std::endl; return false; }
+        }
+        else if (arg == "--integrator")
+        {
+            if (value == "euler")           options.integrator = IntegratorType::Euler;
+            else if (value == "leapfrog")   options.integrator = IntegratorType::Leapfrog;
+            else if (value == "verlet")     options.integrator = IntegratorType::VelocityVerlet;
+            else if (value == "yoshida4")   options.integrator = IntegratorType::Yoshida4;
+            else { std::cerr << "unknown integrator " << value << std::endl; return false; }
+        }
+        else if (arg == "--drag")
+        {
+            options.drag = value != "none";
+            options.staticDrag = value == "static-isa";
+            if (value == "none" || value == "isa" || value == "static-isa") options.atmosphere = AtmosphereType::ISA;
+            else if (value == "tabulated")      options.atmosphere = AtmosphereType::TabulatedISA;
+            else if (value == "us76")           options.atmosphere = AtmosphereType::US76;
+            else if (value == "spaceweather")   options.atmosphere = AtmosphereType::SpaceWeather;
+            else { std::cerr << "unknown drag model " << value << std::endl; return false; }
+        }
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+    if (!options.spaceWeather.empty() && !(options.drag && options.atmosphere == AtmosphereType::SpaceWeather)) {
+        std::cerr << "--space-weather needs --drag spaceweather" << std::endl;
+        return false;
+    }
+    if (options.frameEvery < 1 || options.width < 1 || options.height < 1) {
+        std::cerr << "--frame-every, --width and --height must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,20 @@
+#include "IntegratorFactory.h"
+#include "Integrators.h"
+#include <stdexcept>
+
+std::unique_ptr<Integrator> IntegratorFactory::createIntegrator(IntegratorType type)
+{
+    switch (type) {
+        case IntegratorType::Euler:
+            return std::make_unique<EulerIntegrator>();
+        case IntegratorType::Leapfrog:
+            return std::make_unique<LeapfrogIntegrator>();
+        case IntegratorType::VelocityVerlet:
+            return std::make_unique<VelocityVerletIntegrator>();
+        case IntegratorType::Yoshida4:
+            return std::make_unique<Yoshida4Integrator>();
+        default:
+            throw std::runtime_error("Unknown IntegratorType!");
+
+    }
+}
@@ -0,0 +1,63 @@
+#include "Integrators.h"
+#include "Simulation.h"
+#include <cmath>
+
+namespace
+{
+    // Yoshida (1990) coefficients for the 4th order composition of leapfrog:
+    //   w1 = 1 / (2 - 2^(1/3)),  w0 = -2^(1/3) / (2 - 2^(1/3))
+    const double CBRT2 = std::cbrt(2.0);
+    const double W1 = 1.0 / (2.0 - CBRT2);
+    const double W0 = -CBRT2 / (2.0 - CBRT2);
+
+    // drift weights c1..c4 and kick weights d1..d3
+    const float C1 = static_cast<float>(0.5 * W1);
+    const float C2 = static_cast<float>(0.5 * (W0 + W1));
+    const float D1 = static_cast<float>(W1);
+    const float D2 = static_cast<float>(W0);
+}
+
+//------------------------------------------------------------------------------
+void EulerIntegrator::step(Simulation& simulation, float dt)
+{
+    simulation.computeAccelerations();
+    simulation.kick(dt);
+    simulation.drift(dt);
+}
+
+//------------------------------------------------------------------------------
+void LeapfrogIntegrator::step(Simulation& simulation, float dt)
+{
+    simulation.drift(0.5f * dt);
+    simulation.computeAccelerations();
+    simulation.kick(dt);
+    simulation.drift(0.5f * dt);
+}
+
+//------------------------------------------------------------------------------
+void VelocityVerletIntegrator::step(Simulation& simulation, float dt)
+{
+    // a(t) is still valid if the previous step ended with a force evaluation
+    if (!simulation.accelerationsValid())
+        simulation.computeAccelerations();
+
+    simulation.kick(0.5f * dt);
+    simulation.drift(dt);
+    simulation.computeAccelerations();
+    simulation.kick(0.5f * dt);
+}
+
+//------------------------------------------------------------------------------
+void Yoshida4Integrator::step(Simulation& simulation, float dt)
+{
+    simulation.drift(C1 * dt);
+    simulation.computeAccelerations();
+    simulation.kick(D1 * dt);
+    simulation.drift(C2 * dt);
+    simulation.computeAccelerations();
+    simulation.kick(D2 * dt);
+    simulation.drift(C2 * dt);
+    simulation.computeAccelerations();
+    simulation.kick(D1 * dt);
+    simulation.drift(C1 * dt);
+}
@@ -3,11 +3,23 @@
 #include <vector>
 #include <cmath>
 #include "Object.h"
+#include "ParticleSystem.h"
 
 #include <glew.h>
 #include <GLFW/glfw3.h>
 
 #include "AtmosphereFactory.h"
+#include "GravitySolverFactory.h"
+#include "ThreadPool.h"
+#include "Simulation.h"
+#include "SimulationRunner.h"
+#include "StaticDrag.h"
+#include "IntegratorFactory.h"
+#include "Scenarios.h"
+#include "CircleRenderer.h"
+#include "LineRenderer.h"
+#include "TrailBuffer.h"
+#include "DrawList.h"
 #include "constants.h"
 /*
 #include <glm/gtc/matrix_transform.hpp>
@@ -17,6 +29,13 @@
 
 
 
+// Physics runs on its own thread at PHYSICS_RATE steps per second, advancing
+// TICKS_PER_SECOND simulation ticks every wall-clock second (the original loop
+// took one tick per 60 Hz frame), whatever the display manages.
+constexpr double PHYSICS_RATE = 1000.0;
+constexpr double TICKS_PER_SECOND = 60.0;
+
+
 //function declarations
 GLFWwindow* StartGLFW(); //  A function StartGLFW that returns a pointer to a window
 GLFWwindow*  setUpSimulation();
@@ -29,7 +48,15 @@ void checkScreenCollision(Object &obj);
 //initiate main
 int main() {
 
-    auto atmosphere = AtmosphereFactory::createAtmosphere(AtmosphereType::ISA);
+    // one persistent set of workers for the whole run (uses every core by default)
+    ThreadPool pool;
+    // the direct sums are exact; switch to BarnesHut for large numbers of bodies
+    Simulation simulation(GravitySolverFactory::createSolver(GravitySolverType::SymmetricDirectSum), &pool,
+                          IntegratorFactory::createIntegrator(IntegratorType::VelocityVerlet));
+    // drag from the ISA around body 0 (the Earth of the Earth-Moon scenario),
+    // through the compile-time model; for a runtime choice use
+    // std::make_unique<AtmosphericDrag>(AtmosphereFactory::createAtmosphere(type), 0)
+    simulation.setDrag(std::make_unique<StaticIsaDrag>(0));
 
 
     // run all pre things
@@ -42,45 +69,47 @@ int main() {
 
 
 
-    std::vector<Object> objs = {
-            Object(std::vector<float>{constants::screenWidth/2,constants::screenHeight/2},std::vector<float>{0,0},5.972* pow(10,24),20),
-            Object(std::vector<float>{2*constants::screenWidth/3,constants::screenHeight/2},std::vector<float>{0,-10},7.35* pow(10,22),5),
-    };
+    scenarios::addEarthMoon(simulation.particles());
 
+    // one instanced draw call for every body (immediate mode if GL 3.3 is missing)
+    CircleRenderer renderer;
+    renderer.init();
+    // trails: one batched line-strip draw, underneath the bodies
+    LineRenderer lineRenderer;
+    lineRenderer.init();
+    TrailBuffer trails;
+    std::uint64_t trailStep = 0;
+    DrawList drawList;
+    // world pixels map 1:1 onto the window (scale / offset zoom and pan it)
+    drawList.setView(ViewTransform(constants::screenWidth, constants::screenHeight));
+
+    SimulationRunner runner(simulation, PHYSICS_RATE, static_cast<float>(TICKS_PER_SECOND / PHYSICS_RATE));
+    runner.start();
 
     while(!glfwWindowShouldClose(window))
     {
         glfwMakeContextCurrent( window );
         glClear(GL_COLOR_BUFFER_BIT);
-        glColor3f(1.0f, 1.0f, 1.0f);
-
-        for (auto& obj : objs){
-
-            for (auto& obj2 :objs){
-                if (&obj2 == &obj){continue;};
-                float dx = obj2.position[0] - obj.position[0];
-                float dy =  obj2.position[1] - obj.position[1];
-                float distance = sqrt(dx*dx+dy*dy);
-                std::vector<float> direction = {dx/distance,dy/distance};
-                distance *=100000;
-
-                float Gforce = (constants::GRAV_CONST * obj.mass *obj2.mass / (distance*distance));
-                float acc1 = Gforce / obj.mass;
-
-                std::vector<float> acc = {acc1*direction[0],acc1*direction[1]};
-                obj.accelerate(acc[0],acc[1]);
-            }
-            obj.updatePos();
-            obj.DrawCircle(100);
-            //obj.checkCollisionWithScreen(screenWidth,screenHeight);
-
-
-
-
-
 
+        // newest finished step, never waiting for the physics thread; bodies
+        // are shown between its start and end positions for smooth motion
+        const SimulationSnapshot& snapshot = runner.latest();
+        const float blend = snapshot.blendFactor(SimulationSnapshot::Clock::now());
+        // trails sample the published steps (at most one per frame)
+        if (snapshot.steps != trailStep)
+        {
+            trails.record(snapshot.x.data(), snapshot.y.data(), snapshot.size());
+            trailStep = snapshot.steps;
         }
 
+        // OpenGL calls stay on this thread; off-screen bodies are culled and
+        // the rest tessellated by their size on screen
+        drawList.clear();
+        trails.addTo(drawList, packColor(90, 110, 160));
+        drawList.addBodies(snapshot, blend);
+        lineRenderer.draw(drawList);
+        renderer.draw(drawList);
+
 
 
 
@@ -91,9 +120,15 @@ int main() {
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+    runner.stop();
+
 
 
 
+    // atmosphere diagnostics are polled here, off the physics hot path
+    if (const std::uint64_t vacuum = simulation.drag()->atmosphere().takeVacuumQueryCount())
+        std::cerr << "[atmosphere] " << vacuum << " queries above the atmosphere "
+                  << "(density < 1e-6 of sea level)" << std::endl;
 
     glfwTerminate();
     return 0;
@@ -112,6 +147,11 @@ GLFWwindow*  setUpSimulation()
     GLFWwindow* window = StartGLFW(); // Call function and create variable window, which is an instance of a pointer to a GLFWwindow object
     glfwMakeContextCurrent( window );
 
+    // load the GL 3.3 entry points used by the instanced renderer
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+        std::cerr << "failed to initialize glew, falling back to immediate mode" << std::endl;
+
     // Set up the viewport and projection once, after window creation
     glViewport(0, 0, static_cast<GLsizei>(constants::screenWidth), static_cast<GLsizei>(constants::screenHeight)); //specifies the part of the window to which OpenGL will draw (in pixels), convert from normalised to pixels
     glMatrixMode(GL_PROJECTION);  // projection matrix defines the properties of the camera that views the objects in the world coordinate frame. Here you typically set the zoom factor, aspect ratio and the near and far clipping planes
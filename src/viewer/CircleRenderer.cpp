@@ -0,0 +1,211 @@
+#include "CircleRenderer.h"
+#include "CircleMesh.h"
+#include "ShaderProgram.h"
+#include <glew.h>
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <iostream>
+
+namespace
+{
+    const char* VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 unitPosition;   // unit circle mesh
+layout(location = 1) in vec3 instance;       // x, y, radius
+layout(location = 2) in vec4 instanceColor;  // RGBA8, normalised
+uniform vec4 transform;                      // world -> clip: xy * scale + offset
+out vec4 colour;
+void main()
+{
+    vec2 world = instance.xy + unitPosition * instance.z;
+    gl_Position = vec4(world * transform.xy + transform.zw, 0.0, 1.0);
+    colour = instanceColor;
+}
+)";
+
+    const char* FRAGMENT_SHADER = R"(#version 330 core
+in vec4 colour;
+out vec4 fragColour;
+void main()
+{
+    fragColour = colour;
+}
+)";
+}
+
+//------------------------------------------------------------------------------
+CircleRenderer::CircleRenderer()
+{
+    std::vector<Vec2> fan;
+    for (int level = 0; level < CIRCLE_LOD_LEVELS; ++level)
+    {
+        tessellateCircle({0.0f, 0.0f}, 1.0f, CIRCLE_LOD_SEGMENTS[level], fan);
+        fanFirst[level] = static_cast<int>(unitFans.size());
+        fanCount[level] = static_cast<int>(fan.size());
+        unitFans.insert(unitFans.end(), fan.begin(), fan.end());
+    }
+}
+
+//------------------------------------------------------------------------------
+CircleRenderer::~CircleRenderer()
+{
+    release();
+}
+
+//------------------------------------------------------------------------------
+void CircleRenderer::release()
+{
+    if (!useInstancing)
+        return;
+    glDeleteBuffers(1, &instanceBuffer);
+    glDeleteBuffers(1, &meshBuffer);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteProgram(program);
+    useInstancing = false;
+}
+
+//------------------------------------------------------------------------------
+bool CircleRenderer::init()
+{
+    release();
+
+    if (!GLEW_VERSION_3_3)
+    {
+        std::cerr << "[CircleRenderer] OpenGL 3.3 not available, using immediate mode" << std::endl;
+        return false;
+    }
+
+    program = buildShaderProgram(VERTEX_SHADER, FRAGMENT_SHADER, "CircleRenderer");
+    if (!program)
+        return false;
+    transformLocation = glGetUniformLocation(program, "transform");
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    // shared unit circle, uploaded once
+    glGenBuffers(1, &meshBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, meshBuffer);
+    glBufferData(GL_ARRAY_BUFFER, unitFans.size() * sizeof(Vec2), unitFans.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vec2), nullptr);
+
+    // per-instance records, refilled every frame (one attribute step per
+    // instance); the pointers are set per batch in drawInstances
+    glGenBuffers(1, &instanceBuffer);
+    instanceCapacity = 0;
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    useInstancing = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void CircleRenderer::draw(const DrawList& list)
+{
+    if (!useInstancing)
+    {
+        drawImmediate(list);
+        return;
+    }
+
+    const std::size_t total = list.circleCount() + list.pointCount();
+    if (total == 0)
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    // grow geometrically so the store is reallocated only a few times
+    if (total > instanceCapacity)
+        instanceCapacity = total + total / 2;
+    // re-specifying the store orphans last frame's copy, so the uploads below
+    // never wait for the GPU to finish drawing from it
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity * sizeof(CircleInstance)),
+                 nullptr, GL_STREAM_DRAW);
+
+    // every batch back to back in the one buffer
+    std::size_t levelOffset[CIRCLE_LOD_LEVELS];
+    std::size_t offset = 0;
+    for (int level = 0; level < CIRCLE_LOD_LEVELS; ++level)
+    {
+        const std::vector<CircleInstance>& circles = list.circleInstances(level);
+        levelOffset[level] = offset;
+        if (!circles.empty())
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+                            static_cast<GLsizeiptr>(circles.size() * sizeof(CircleInstance)), circles.data());
+        offset += circles.size() * sizeof(CircleInstance);
+    }
+    const std::vector<CircleInstance>& points = list.pointInstances();
+    if (!points.empty())
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+                        static_cast<GLsizeiptr>(points.size() * sizeof(CircleInstance)), points.data());
+
+    glUseProgram(program);
+    setViewUniform(transformLocation, list.view());
+    glBindVertexArray(vao);
+
+    for (int level = 0; level < CIRCLE_LOD_LEVELS; ++level)
+        drawInstances(GL_TRIANGLE_FAN, fanFirst[level], fanCount[level],
+                      levelOffset[level], list.circleInstances(level).size());
+    // the fans start with the centre, so a point is just their first vertex
+    drawInstances(GL_POINTS, 0, 1, offset, points.size());
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//------------------------------------------------------------------------------
+void CircleRenderer::drawInstances(unsigned int mode, int first, int count,
+                                   std::size_t byteOffset, std::size_t instances)
+{
+    if (instances == 0)
+        return;
+
+    // GL 3.3 has no base-instance draw, so point the instance attributes at
+    // this batch's part of the buffer instead
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(CircleInstance),
+                          reinterpret_cast<const void*>(byteOffset + offsetof(CircleInstance, x)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CircleInstance),
+                          reinterpret_cast<const void*>(byteOffset + offsetof(CircleInstance, color)));
+    glDrawArraysInstanced(mode, first, count, static_cast<GLsizei>(instances));
+}
+
+//------------------------------------------------------------------------------
+void CircleRenderer::drawImmediate(const DrawList& list)
+{
+    // fixed-function fallback, in screen pixels (the glOrtho set up in main)
+    const ViewTransform& view = list.view();
+    auto setColor = [](std::uint32_t c)
+    {
+        glColor4ub(c & 0xff, (c >> 8) & 0xff, (c >> 16) & 0xff, c >> 24);
+    };
+
+    for (int level = 0; level < CIRCLE_LOD_LEVELS; ++level)
+    {
+        const Vec2* fan = unitFans.data() + fanFirst[level];
+        for (const CircleInstance& c : list.circleInstances(level))
+        {
+            const float x = view.toScreenX(c.x);
+            const float y = view.toScreenY(c.y);
+            const float r = c.radius * view.scale;
+            setColor(c.color);
+            glBegin(GL_TRIANGLE_FAN);
+            for (int k = 0; k < fanCount[level]; ++k)
+                glVertex2f(x + fan[k].x * r, y + fan[k].y * r);
+            glEnd();
+        }
+    }
+
+    glBegin(GL_POINTS);
+    for (const CircleInstance& c : list.pointInstances())
+    {
+        setColor(c.color);
+        glVertex2f(view.toScreenX(c.x), view.toScreenY(c.y));
+    }
+    glEnd();
+}
@@ -0,0 +1,142 @@
+#include "LineRenderer.h"
+#include "ShaderProgram.h"
+#include <glew.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+
+namespace
+{
+    const char* VERTEX_SHADER = R"(#version 330 core
+layout(location = 0) in vec2 position;   // world coordinates
+uniform vec4 transform;                  // world -> clip: xy * scale + offset
+void main()
+{
+    gl_Position = vec4(position * transform.xy + transform.zw, 0.0, 1.0);
+}
+)";
+
+    const char* FRAGMENT_SHADER = R"(#version 330 core
+uniform vec4 colour;
+out vec4 fragColour;
+void main()
+{
+    fragColour = colour;
+}
+)";
+}
+
+//------------------------------------------------------------------------------
+LineRenderer::~LineRenderer()
+{
+    release();
+}
+
+//------------------------------------------------------------------------------
+void LineRenderer::release()
+{
+    if (!useBuffers)
+        return;
+    glDeleteBuffers(1, &vertexBuffer);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteProgram(program);
+    useBuffers = false;
+}
+
+//------------------------------------------------------------------------------
+bool LineRenderer::init()
+{
+    release();
+
+    if (!GLEW_VERSION_3_3)
+    {
+        std::cerr << "[LineRenderer] OpenGL 3.3 not available, using immediate mode" << std::endl;
+        return false;
+    }
+
+    program = buildShaderProgram(VERTEX_SHADER, FRAGMENT_SHADER, "LineRenderer");
+    if (!program)
+        return false;
+    transformLocation = glGetUniformLocation(program, "transform");
+    colorLocation = glGetUniformLocation(program, "colour");
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    vertexCapacity = 0;
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vec2), nullptr);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    useBuffers = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void LineRenderer::draw(const DrawList& list)
+{
+    const std::vector<LineStrip>& strips = list.lineStrips();
+    if (strips.empty())
+        return;
+
+    if (!useBuffers)
+    {
+        drawImmediate(list);
+        return;
+    }
+
+    const std::vector<Vec2>& vertices = list.lineVertices();
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    // grow geometrically; re-specifying the store orphans last frame's copy
+    if (vertices.size() > vertexCapacity)
+        vertexCapacity = vertices.size() + vertices.size() / 2;
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity * sizeof(Vec2)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(vertices.size() * sizeof(Vec2)), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(program);
+    setViewUniform(transformLocation, list.view());
+    glBindVertexArray(vao);
+
+    // one multi-draw per run of strips sharing a colour
+    std::size_t runBegin = 0;
+    while (runBegin < strips.size())
+    {
+        const std::uint32_t color = strips[runBegin].color;
+        firsts.clear();
+        counts.clear();
+        std::size_t k = runBegin;
+        for (; k < strips.size() && strips[k].color == color; ++k)
+        {
+            firsts.push_back(static_cast<int>(strips[k].first));
+            counts.push_back(static_cast<int>(strips[k].count));
+        }
+
+        glUniform4f(colorLocation, (color & 0xff) / 255.0f, ((color >> 8) & 0xff) / 255.0f,
+                    ((color >> 16) & 0xff) / 255.0f, (color >> 24) / 255.0f);
+        glMultiDrawArrays(GL_LINE_STRIP, firsts.data(), counts.data(), static_cast<GLsizei>(firsts.size()));
+        runBegin = k;
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+//------------------------------------------------------------------------------
+void LineRenderer::drawImmediate(const DrawList& list)
+{
+    // fixed-function fallback, in screen pixels (the glOrtho set up in main)
+    const ViewTransform& view = list.view();
+    const std::vector<Vec2>& vertices = list.lineVertices();
+
+    for (const LineStrip& strip : list.lineStrips())
+    {
+        const std::uint32_t c = strip.color;
+        glColor4ub(c & 0xff, (c >> 8) & 0xff, (c >> 16) & 0xff, c >> 24);
+        glBegin(GL_LINE_STRIP);
+        for (std::uint32_t k = strip.first; k < strip.first + strip.count; ++k)
+            glVertex2f(view.toScreenX(vertices[k].x), view.toScreenY(vertices[k].y));
+        glEnd();
+    }
+}
@@ -0,0 +1,67 @@
+#include "ShaderProgram.h"
+#include <glew.h>
+#include <iostream>
+
+namespace
+{
+    GLuint compileShader(GLenum type, const char* source, const char* owner)
+    {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint ok = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok)
+        {
+            char log[1024];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << "[" << owner << "] shader compile failed: " << log << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+//------------------------------------------------------------------------------
+unsigned int buildShaderProgram(const char* vertexSource, const char* fragmentSource, const char* owner)
+{
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexSource, owner);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, fragmentSource, owner);
+    if (!vertex || !fragment)
+    {
+        if (vertex) glDeleteShader(vertex);
+        if (fragment) glDeleteShader(fragment);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    glDeleteShader(vertex);     // freed together with the program
+    glDeleteShader(fragment);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "[" << owner << "] program link failed: " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+//------------------------------------------------------------------------------
+void setViewUniform(int location, const ViewTransform& view)
+{
+    // world -> screen (view) -> clip: [0, w] x [0, h] -> [-1, 1]^2
+    const float sx = 2.0f / view.width;
+    const float sy = 2.0f / view.height;
+    glUniform4f(location, view.scale * sx, view.scale * sy,
+                view.offsetX * sx - 1.0f, view.offsetY * sy - 1.0f);
+}
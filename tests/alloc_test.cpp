@@ -0,0 +1,125 @@
+// Checks that Simulation::step never touches the heap once warmed up, for
+// every gravity solver x integrator, without drag, with the runtime
+// atmospheric drag and with the compile-time one (StaticDrag).
+// Global operator new/delete are replaced with counting versions; any
+// allocation during the measured steps fails the test.
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "AtmosphereFactory.h"
+#include "GravitySolverFactory.h"
+#include "IntegratorFactory.h"
+#include "Scenarios.h"
+#include "Simulation.h"
+#include "StaticDrag.h"
+#include "ThreadPool.h"
+
+namespace
+{
+    std::atomic<bool> counting{false};
+    std::atomic<std::size_t> allocations{0};
+
+    void* countedAlloc(std::size_t size, std::size_t alignment)
+    {
+        if (counting.load(std::memory_order_relaxed))
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0)
+            size = 1;
+        void* p = alignment > alignof(std::max_align_t)
+                  ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                  : std::malloc(size);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size) { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t a) { return countedAlloc(size, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t size, std::align_val_t a) { return countedAlloc(size, static_cast<std::size_t>(a)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+
+namespace
+{
+    const std::pair<GravitySolverType, const char*> SOLVERS[] = {
+            {GravitySolverType::DirectSum,          "DirectSum"},
+            {GravitySolverType::SymmetricDirectSum, "SymmetricDirectSum"},
+            {GravitySolverType::SimdDirectSum,      "SimdDirectSum"},
+            {GravitySolverType::BarnesHut,          "BarnesHut"},
+    };
+    const std::pair<IntegratorType, const char*> INTEGRATORS[] = {
+            {IntegratorType::Euler,          "Euler"},
+            {IntegratorType::Leapfrog,       "Leapfrog"},
+            {IntegratorType::VelocityVerlet, "VelocityVerlet"},
+            {IntegratorType::Yoshida4,       "Yoshida4"},
+    };
+
+    enum class Drag { None, Runtime, Static };
+    const std::pair<Drag, const char*> DRAGS[] = {
+            {Drag::None,    ""},
+            {Drag::Runtime, " / drag"},
+            {Drag::Static,  " / static drag"},
+    };
+
+    constexpr int MEASURED_STEPS = 5;
+
+    // allocations made by MEASURED_STEPS steps after one warm-up step
+    std::size_t allocationsPerRun(GravitySolverType solver, IntegratorType integrator, Drag drag, ThreadPool& pool)
+    {
+        Simulation simulation(GravitySolverFactory::createSolver(solver), &pool,
+                              IntegratorFactory::createIntegrator(integrator));
+        if (drag == Drag::Runtime)
+            simulation.setDrag(std::make_unique<AtmosphericDrag>(
+                    AtmosphereFactory::createAtmosphere(AtmosphereType::ISA), 0));
+        else if (drag == Drag::Static)
+            simulation.setDrag(std::make_unique<StaticIsaDrag>(0));
+        scenarios::addOrbitingDisk(simulation.particles(), 511);
+
+        simulation.step(1.0f);   // sizes the scratch buffers / tree
+
+        allocations.store(0);
+        counting.store(true);
+        for (int k = 0; k < MEASURED_STEPS; ++k)
+            simulation.step(1.0f);
+        counting.store(false);
+        return allocations.load();
+    }
+}
+
+
+
+int main() {
+
+    ThreadPool pool(4);
+    int failures = 0;
+
+    for (const auto& solver : SOLVERS)
+        for (const auto& integrator : INTEGRATORS)
+            for (const auto& drag : DRAGS)
+            {
+                const std::size_t count = allocationsPerRun(solver.first, integrator.first, drag.first, pool);
+                const std::string name = std::string(solver.second) + " / " + integrator.second + drag.second;
+                if (count != 0) {
+                    std::cerr << "FAIL " << name << ": " << count << " allocations in "
+                              << MEASURED_STEPS << " steps" << std::endl;
+                    ++failures;
+                }
+                else
+                    std::cout << "ok   " << name << std::endl;
+            }
+
+    return failures == 0 ? 0 : 1;
+}
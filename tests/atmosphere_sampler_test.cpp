@@ -0,0 +1,107 @@
+// Checks the AtmosphereSampler memo: a repeated altitude is answered without
+// evaluating the model, a new altitude is evaluated, and the memo is dropped
+// once advanceTo() changes the model (generation()) but kept when it does not.
+// Also runs a real SpaceWeatherAtmosphere through a storm.
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "AtmosphereSampler.h"
+#include "SpaceWeatherAtmosphere.h"
+
+namespace
+{
+    // Exponential air whose scale height can be changed by advanceTo(); counts
+    // every model evaluation.
+    class CountingAtmosphere: public Atmosphere {
+    public:
+        mutable int evaluations = 0;
+
+        double getTemperature(double altitude) const override { return getState(altitude).temperature; }
+        double getPressure(double altitude) const override { return getState(altitude).pressure; }
+        double getDensity(double altitude) const override { return getState(altitude).density; }
+
+        void getProperties(double altitudeMeters, double &temperature, double &pressure, double &density) const override
+        {
+            ++evaluations;
+            temperature = 250.0;
+            density = 1.225 * std::exp(-altitudeMeters / scaleHeight);
+            pressure = density * constants::R_AIR * temperature;
+        }
+
+        // a new scale height from t = 100 s on; nothing changes before that
+        void advanceTo(double timeSeconds) override
+        {
+            const double next = timeSeconds >= 100.0 ? 6000.0 : 8000.0;
+            if (next != scaleHeight)
+                markChanged();
+            scaleHeight = next;
+        }
+
+    private:
+        double scaleHeight = 8000.0;
+    };
+
+    int failures = 0;
+
+    void check(bool ok, const std::string& what)
+    {
+        (ok ? std::cout : std::cerr) << (ok ? "ok   " : "FAIL ") << what << std::endl;
+        failures += ok ? 0 : 1;
+    }
+}
+
+
+
+int main() {
+
+    CountingAtmosphere model;
+    AtmosphereSampler sampler(model);
+
+    const double rho0 = sampler.at(5000.0).density;
+    check(model.evaluations == 1, "first query evaluates the model");
+
+    sampler.at(5000.0);
+    sampler.at(5000.0);
+    check(model.evaluations == 1, "same altitude is answered from the memo");
+
+    sampler.at(6000.0);
+    check(model.evaluations == 2, "new altitude evaluates the model");
+
+    sampler.at(5000.0);
+    check(model.evaluations == 3, "only the last altitude is remembered");
+
+    model.advanceTo(50.0);
+    sampler.at(5000.0);
+    check(model.evaluations == 3, "advanceTo without a change keeps the memo");
+
+    model.advanceTo(150.0);
+    const double rho1 = sampler.at(5000.0).density;
+    check(model.evaluations == 4, "advanceTo with a change drops the memo");
+    check(rho1 == model.getDensity(5000.0) && rho1 < rho0, "memo returns the new state");
+
+    sampler.reset();
+    const int before = model.evaluations;
+    sampler.at(5000.0);
+    check(model.evaluations == before + 1, "reset() drops the memo");
+
+    // a real time-varying model: quiet sun, then a storm from t = 1 day
+    SpaceWeatherRecord quiet, storm;
+    quiet.f107 = quiet.f107a = 70.0;
+    quiet.ap = 4.0;
+    storm.time = 86400.0;
+    storm.f107 = storm.f107a = 250.0;
+    storm.ap = 300.0;
+    SpaceWeatherAtmosphere weather(SpaceWeatherTable({quiet, storm}));
+    AtmosphereSampler weatherSampler(weather);
+
+    const double quietDensity = weatherSampler.at(400000.0).density;
+    weather.advanceTo(3600.0);
+    check(weatherSampler.at(400000.0).density == quietDensity, "space weather: same record, same density");
+    weather.advanceTo(90000.0);
+    const double stormDensity = weatherSampler.at(400000.0).density;
+    check(stormDensity == weather.getDensity(400000.0) && stormDensity > quietDensity,
+          "space weather: storm density after advanceTo");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// Checks SpaceWeatherTable::loadCsv on small files: header detection (also
+// after leading comments), '#' comment and blank lines, CRLF line ends and the
+// rejection of malformed lines, unsorted rows and empty files. Also loads a
+// file through AtmosphereFactory and checks the storm in it raises the
+// density once the model is advanced into it.
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "AtmosphereFactory.h"
+#include "SpaceWeather.h"
+
+namespace
+{
+    const std::string FILE_NAME = "space_weather_csv_test.csv";
+
+    int failures = 0;
+
+    void check(bool ok, const std::string& what)
+    {
+        (ok ? std::cout : std::cerr) << (ok ? "ok   " : "FAIL ") << what << std::endl;
+        failures += ok ? 0 : 1;
+    }
+
+    void writeFile(const std::string& contents)
+    {
+        std::ofstream out(FILE_NAME, std::ios::binary);
+        out << contents;
+    }
+
+    bool loads(const std::string& contents)
+    {
+        writeFile(contents);
+        try {
+            SpaceWeatherTable::loadCsv(FILE_NAME);
+            return true;
+        }
+        catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+}
+
+
+
+int main() {
+
+    writeFile("# quiet sun, then a storm\n"
+              "time,f107,f107a,ap\n"
+              "\n"
+              "0, 70.0, 72.5, 4\n"
+              "   # the storm\n"
+              "86400,250,180,300\r\n"
+              "172800,150.5,151,15,\n");
+    const SpaceWeatherTable table = SpaceWeatherTable::loadCsv(FILE_NAME);
+    check(table.size() == 3, "header, comments and blank line skipped: 3 records");
+    check(table[0].time == 0.0 && table[0].f107 == 70.0 && table[0].f107a == 72.5 && table[0].ap == 4.0,
+          "first record parsed");
+    check(table[1].time == 86400.0 && table[1].ap == 300.0, "CRLF line parsed");
+    check(table[2].f107 == 150.5 && table[2].ap == 15.0, "trailing comma accepted");
+
+    check(loads("0,150,150,15\n86400,150,150,15\n"), "file without header");
+    check(!loads("time,f107,f107a,ap\n0,abc,150,15\n"), "non-numeric field rejected");
+    check(!loads("0,150,150\n"), "missing field rejected");
+    check(!loads("0,150,150,15,7\n"), "extra field rejected");
+    check(!loads("0,150,150,15abc\n"), "trailing garbage rejected");
+    check(!loads("0,150,150,15\ntime,f107,f107a,ap\n"), "header after the data rejected");
+    check(!loads("86400,150,150,15\n0,150,150,15\n"), "unsorted rows rejected");
+    check(!loads("# nothing here\ntime,f107,f107a,ap\n"), "file without records rejected");
+    check(!loads(""), "empty file rejected");
+    std::remove(FILE_NAME.c_str());
+
+    bool missing = false;
+    try {
+        SpaceWeatherTable::loadCsv("does_not_exist.csv");
+    }
+    catch (const std::runtime_error&) {
+        missing = true;
+    }
+    check(missing, "missing file rejected");
+
+    // through the factory: the storm record raises the thermosphere density
+    writeFile("time,f107,f107a,ap\n0,70,70,4\n86400,250,250,300\n");
+    auto atmosphere = AtmosphereFactory::createAtmosphere(AtmosphereType::SpaceWeather, FILE_NAME);
+    const double quiet = atmosphere->getDensity(400000.0);
+    atmosphere->advanceTo(90000.0);
+    const double storm = atmosphere->getDensity(400000.0);
+    check(storm > 2.0 * quiet, "factory model follows the file (storm density > 2x quiet)");
+
+    bool wrongType = false;
+    try {
+        AtmosphereFactory::createAtmosphere(AtmosphereType::ISA, FILE_NAME);
+    }
+    catch (const std::runtime_error&) {
+        wrongType = true;
+    }
+    check(wrongType, "a file for a model without indices is rejected");
+    std::remove(FILE_NAME.c_str());
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+// Checks that the error a TabulatedAtmosphere reports for itself is not
+// smaller than the error it actually makes: every table is compared with its
+// source at random altitudes and no quantity may exceed its reported
+// maxRelativeError*() value. Covers both spacings, including log tables whose
+// intervals straddle the 86 km jump of the ISA/US76 profiles.
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "ISA_atmosphere.h"
+#include "TabulatedAtmosphere.h"
+#include "US76_atmosphere.h"
+
+namespace
+{
+    constexpr int RANDOM_ALTITUDES = 100000;
+
+    double relativeError(double value, double exact)
+    {
+        return std::abs(value - exact) / std::max(std::abs(exact), 1e-300);
+    }
+
+    // number of quantities whose random-altitude error exceeds the reported one
+    int check(const std::string& name, std::unique_ptr<Atmosphere> source, const TableOptions& options)
+    {
+        const TabulatedAtmosphere table(std::move(source), options);
+        const Atmosphere& exact = table.sourceModel();
+
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<double> altitude(options.minAltitude, options.maxAltitude);
+
+        double errorT = 0.0, errorP = 0.0, errorRho = 0.0;
+        for (int i = 0; i < RANDOM_ALTITUDES; ++i)
+        {
+            const double h = altitude(rng);
+            double T, P, rho, T0, P0, rho0;
+            table.getProperties(h, T, P, rho);
+            exact.getProperties(h, T0, P0, rho0);
+            errorT = std::max(errorT, relativeError(T, T0));
+            errorP = std::max(errorP, relativeError(P, P0));
+            errorRho = std::max(errorRho, relativeError(rho, rho0));
+        }
+
+        const std::pair<double, double> results[] = {
+                {errorT,   table.maxRelativeErrorTemperature()},
+                {errorP,   table.maxRelativeErrorPressure()},
+                {errorRho, table.maxRelativeErrorDensity()},
+        };
+        const char* quantities[] = {"T", "P", "rho"};
+
+        int failures = 0;
+        for (int q = 0; q < 3; ++q)
+        {
+            const bool ok = results[q].first <= results[q].second;
+            (ok ? std::cout : std::cerr) << (ok ? "ok   " : "FAIL ") << name << " " << quantities[q]
+                                         << ": random " << results[q].first
+                                         << ", reported " << results[q].second << std::endl;
+            failures += ok ? 0 : 1;
+        }
+        return failures;
+    }
+}
+
+
+
+int main() {
+
+    TableOptions uniform;
+    TableOptions logarithmic;
+    logarithmic.spacing = TableSpacing::Logarithmic;
+    logarithmic.samples = 2001;
+
+    int failures = 0;
+    failures += check("ISA / uniform", std::make_unique<ISA_atmosphere>(), uniform);
+    failures += check("ISA / log", std::make_unique<ISA_atmosphere>(), logarithmic);
+    failures += check("US76 / uniform", std::make_unique<US76_atmosphere>(), uniform);
+    failures += check("US76 / log", std::make_unique<US76_atmosphere>(), logarithmic);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// Checks TrailBuffer: the oldest-to-newest order survives the ring wrapping
+// around, addTo() emits exactly point(body, 0..length-1) for every trail
+// (also when a trail is split across the end of its ring), and the stride /
+// bend decimation keeps straight paths sparse and curved ones fine.
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DrawList.h"
+#include "TrailBuffer.h"
+#include "ViewTransform.h"
+#include "constants.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool ok, const std::string& what)
+    {
+        (ok ? std::cout : std::cerr) << (ok ? "ok   " : "FAIL ") << what << std::endl;
+        failures += ok ? 0 : 1;
+    }
+
+    // stride 1: every sample is kept, so after samples 0..K the trail is the
+    // last capacity - 1 of 0, 1, ..., K followed by the live point (K again)
+    void checkWrapOrder()
+    {
+        const std::size_t capacity = 8;
+        TrailBuffer trails(capacity, 1);
+        const int samples = 20;   // wraps the ring twice
+        for (int k = 0; k < samples; ++k)
+        {
+            const float x = 100.0f + k;
+            const float y = 200.0f;
+            trails.record(&x, &y, 1);
+        }
+
+        bool ordered = trails.length(0) == capacity;
+        for (std::size_t k = 0; k + 1 < capacity; ++k)
+            ordered = ordered && trails.point(0, k).x == 100.0f + (samples - capacity + 1) + k;
+        ordered = ordered && trails.point(0, capacity - 1).x == 100.0f + samples - 1;
+        check(ordered, "oldest-to-newest order survives the wrap");
+    }
+
+    // one trail per sample count 1..40: short ones, full ones, and rings
+    // whose newest point sits anywhere, so many are stored in two pieces;
+    // every strip must be the trail read through point()
+    void checkAddTo()
+    {
+        const std::size_t capacity = 16;
+        bool same = true;
+        for (int samples = 1; same && samples <= 40; ++samples)
+        {
+            TrailBuffer trails(capacity, 1);
+            for (int k = 0; k < samples; ++k)
+            {
+                const float x = 100.0f + 4.0f * k;
+                const float y = 100.0f + 2.0f * k;
+                trails.record(&x, &y, 1);
+            }
+
+            DrawList list;
+            list.setView(ViewTransform(constants::screenWidth, constants::screenHeight));
+            trails.addTo(list, COLOR_WHITE);
+
+            same = list.lineStrips().size() == 1 && list.lineStrips()[0].count == trails.length(0);
+            for (std::size_t k = 0; same && k < trails.length(0); ++k)
+            {
+                const Vec2 a = list.lineVertices()[list.lineStrips()[0].first + k];
+                const Vec2 b = trails.point(0, k);
+                same = a.x == b.x && a.y == b.y;
+            }
+        }
+        check(same, "addTo() strips match point(body, k)");
+    }
+
+    // a straight path keeps about one point per stride samples, a circle
+    // (which leaves the straight continuation quickly) many more
+    void checkDecimation()
+    {
+        const std::size_t capacity = 256;
+        const unsigned stride = 8;
+        const int samples = 200;
+        TrailBuffer trails(capacity, stride, 0.5f);
+        for (int k = 0; k < samples; ++k)
+        {
+            const float angle = 0.05f * k;
+            const float x[2] = {100.0f + 3.0f * k, 700.0f + 100.0f * std::cos(angle)};
+            const float y[2] = {100.0f, 500.0f + 100.0f * std::sin(angle)};
+            trails.record(x, y, 2);
+        }
+
+        const std::size_t straight = trails.length(0);
+        const std::size_t curved = trails.length(1);
+        const std::size_t expected = (samples - 1) / stride + 2;   // first point, one per stride, live point
+        std::cout << "     straight " << straight << " points, curved " << curved
+                  << " points for " << samples << " samples" << std::endl;
+        check(straight >= expected - 1 && straight <= expected + 1, "straight path keeps one point per stride");
+        check(curved > 2 * straight, "curved path keeps more points than a straight one");
+    }
+}
+
+
+
+int main() {
+
+    checkWrapOrder();
+    checkAddTo();
+    checkDecimation();
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Checks TripleBuffer's hand-over between one writer and one reader thread:
+// the writer publishes increasing sequence numbers (each value fills a whole
+// block with its number), the reader must never see the numbers go backwards,
+// must see a new number whenever update() says so, and must never see a block
+// mixing two values. Also checks the single-threaded basics.
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "TripleBuffer.h"
+
+namespace
+{
+    constexpr std::uint64_t VALUES = 1000000;
+    constexpr int WORDS = 32;
+
+    struct Block
+    {
+        std::uint64_t word[WORDS] = {};
+    };
+
+    void fill(Block& block, std::uint64_t value)
+    {
+        for (std::uint64_t& w : block.word)
+            w = value;
+    }
+
+    bool consistent(const Block& block)
+    {
+        for (std::uint64_t w : block.word)
+            if (w != block.word[0])
+                return false;
+        return true;
+    }
+
+    int failures = 0;
+
+    void check(bool ok, const std::string& what)
+    {
+        (ok ? std::cout : std::cerr) << (ok ? "ok   " : "FAIL ") << what << std::endl;
+        failures += ok ? 0 : 1;
+    }
+}
+
+
+
+int main() {
+
+    // single thread: nothing to pick up until something is published, then
+    // only the newest value
+    {
+        TripleBuffer<Block> buffer;
+        check(!buffer.update(), "nothing published: update() is false");
+        fill(buffer.writeBuffer(), 1);
+        buffer.publish();
+        fill(buffer.writeBuffer(), 2);
+        buffer.publish();
+        check(buffer.update() && buffer.readBuffer().word[0] == 2, "update() picks up the newest value");
+        check(!buffer.update() && buffer.readBuffer().word[0] == 2, "no new value: update() is false, value kept");
+    }
+
+    // one writer, one reader
+    TripleBuffer<Block> buffer;
+    std::thread writer([&buffer]
+    {
+        for (std::uint64_t value = 1; value <= VALUES; ++value)
+        {
+            fill(buffer.writeBuffer(), value);
+            buffer.publish();
+            // let the reader in now and then, so the two interleave even on one core
+            if (value % 16 == 0)
+                std::this_thread::yield();
+        }
+    });
+
+    std::uint64_t last = 0, updates = 0;
+    bool monotonic = true, whole = true;
+    while (last < VALUES && monotonic && whole)
+    {
+        if (!buffer.update())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const Block& block = buffer.readBuffer();
+        whole = consistent(block);
+        monotonic = block.word[0] > last;
+        last = block.word[0];
+        ++updates;
+    }
+    writer.join();
+
+    check(whole, "reader never sees a half-written value");
+    check(monotonic, "sequence numbers never go backwards");
+    check(last == VALUES, "reader ends on the last value");
+    std::cout << "     " << updates << " of " << VALUES << " values picked up" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}